@@ -0,0 +1,310 @@
+#include <archive/game_archive.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <chess.hpp>
+
+#include <engines/uci_info.hpp>
+#include <matchmaking/book/bin_book.hpp>
+#include <pgn/pgn_builder.hpp>
+#include <util/binary_io.hpp>
+#include <util/logger/logger.hpp>
+
+namespace fast_chess {
+
+using namespace binary_io;
+
+namespace {
+
+constexpr char MAGIC[4]           = {'F', 'C', 'G', 'A'};
+constexpr std::size_t HEADER_SIZE = 6;
+
+constexpr uint8_t FLAG_CHESS960 = 1;
+constexpr uint8_t FLAG_ILLEGAL  = 2;
+
+/// @brief How the score of a move was reported, kept next to the score itself.
+enum ScoreKind : uint8_t { NO_SCORE, CP_SCORE, MATE_SCORE, ERR_SCORE };
+
+[[nodiscard]] ScoreKind scoreKind(const std::string &score_string) noexcept {
+    // moves without engine output, like the opening moves
+    if (score_string == "0.00") return NO_SCORE;
+    if (score_string == "ERR") return ERR_SCORE;
+    if (score_string.size() > 1 && score_string[1] == 'M') return MATE_SCORE;
+    return CP_SCORE;
+}
+
+void writeTimeControl(std::string &out, const TimeControl &tc) {
+    writeVarint(out, tc.time);
+    writeVarint(out, tc.increment);
+    writeVarint(out, tc.moves);
+    writeVarint(out, tc.fixed_time);
+}
+
+[[nodiscard]] TimeControl readTimeControl(const char *&data, const char *end) noexcept {
+    TimeControl tc;
+    tc.time       = readVarint(data, end);
+    tc.increment  = readVarint(data, end);
+    tc.moves      = readVarint(data, end);
+    tc.fixed_time = readVarint(data, end);
+    return tc;
+}
+
+[[nodiscard]] std::runtime_error corruptRecord(std::size_t idx) {
+    return std::runtime_error("Corrupt record in game archive: " + std::to_string(idx));
+}
+
+}  // namespace
+
+std::string GameArchive::header() {
+    std::string header(MAGIC, sizeof(MAGIC));
+    writeLe(header, VERSION);
+    return header;
+}
+
+std::string GameArchive::encode(const MatchData &match,
+                                const options::Tournament &tournament_options,
+                                std::size_t round_id) {
+    const bool chess960 = tournament_options.variant == VariantType::FRC;
+
+    chess::Board board;
+    board.set960(chess960);
+    board.setFen(match.fen);
+
+    const bool illegal = !match.moves.empty() && !match.moves.back().legal;
+
+    // the size is filled in once the record is complete
+    std::string out(4, '\0');
+
+    writeLe<uint8_t>(out, (chess960 ? FLAG_CHESS960 : 0) | (illegal ? FLAG_ILLEGAL : 0));
+    writeLe<uint8_t>(out, static_cast<uint8_t>(match.termination));
+    writeLe<uint8_t>(out, static_cast<uint8_t>(int(match.players.first.color)));
+    writeLe<uint8_t>(out, static_cast<uint8_t>(match.players.first.result));
+    writeLe<uint8_t>(out, static_cast<uint8_t>(match.players.second.result));
+    writeVarint(out, round_id);
+
+    for (const auto &str :
+         {tournament_options.event_name, tournament_options.site, match.players.first.config.name,
+          match.players.second.config.name, match.date, match.start_time, match.end_time,
+          match.duration, match.reason}) {
+        writeString(out, str);
+    }
+
+    writeTimeControl(out, match.players.first.config.limit.tc);
+    writeTimeControl(out, match.players.second.config.limit.tc);
+
+    BinBook::encode({match.fen, {}}, out);
+
+    writeVarint(out, match.moves.size());
+
+    for (const auto &move : match.moves) {
+        if (!move.legal) {
+            // not necessarily a move on this board, the text follows at the end
+            writeLe<uint16_t>(out, 0);
+        } else {
+            const auto parsed = chess::uci::uciToMove(board, move.move);
+            writeLe<uint16_t>(out, parsed.move());
+            board.makeMove(parsed);
+        }
+
+        writeVarint(out, (zigzag(move.score) << 2) | scoreKind(move.score_string));
+        writeVarint(out, move.depth);
+        writeVarint(out, move.seldepth);
+        writeVarint(out, move.elapsed_millis);
+        writeVarint(out, move.nodes);
+        writeVarint(out, move.nps);
+    }
+
+    if (illegal) writeString(out, match.moves.back().move);
+
+    const auto size = static_cast<uint32_t>(out.size() - 4);
+    for (int i = 0; i < 4; i++) out[i] = static_cast<char>((size >> (8 * i)) & 0xff);
+
+    return out;
+}
+
+void GameArchive::prepareAppend(const std::string &file) {
+    std::error_code ec;
+
+    if (!std::filesystem::exists(file, ec) || std::filesystem::file_size(file, ec) == 0) {
+        std::ofstream out(file, std::ios::binary | std::ios::trunc);
+        out << header();
+
+        if (!out) throw std::runtime_error("Could not open file: " + file);
+
+        return;
+    }
+
+    std::size_t size     = 0;
+    std::size_t complete = 0;
+
+    {
+        // the file has to be unmapped before it can be resized
+        const GameArchive archive(file);
+        size     = archive.file_.view().size();
+        complete = archive.completeSize();
+    }
+
+    if (complete == size) return;
+
+    Logger::log<Logger::Level::WARN>("Warning; Dropping an incomplete record at the end of",
+                                     file);
+
+    std::filesystem::resize_file(file, complete, ec);
+
+    if (ec) throw std::runtime_error("Could not truncate the game archive: " + file);
+}
+
+GameArchive::GameArchive(const std::string &file) : file_(file) {
+    const auto data = file_.view();
+
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a game archive: " + file);
+    }
+
+    if (readLe<uint16_t>(data.data() + 4) != VERSION) {
+        throw std::runtime_error("Unsupported game archive version: " + file);
+    }
+
+    offsets_ = OffsetIndex(data.size());
+
+    // only the sizes are read, the records themselves are unpacked on access
+    for (std::size_t offset = HEADER_SIZE; offset + 4 <= data.size();) {
+        const std::size_t size = readLe<uint32_t>(data.data() + offset);
+
+        if (data.size() - offset - 4 < size) break;
+
+        offsets_.push_back(offset);
+        offset += 4 + size;
+    }
+
+    offsets_.shrink_to_fit();
+}
+
+std::size_t GameArchive::completeSize() const noexcept {
+    if (offsets_.empty()) return HEADER_SIZE;
+
+    const auto offset = offsets_[offsets_.size() - 1];
+    return offset + 4 + readLe<uint32_t>(file_.view().data() + offset);
+}
+
+GameArchive::Game GameArchive::operator[](std::size_t idx) const {
+    const auto data   = file_.view();
+    const auto offset = offsets_[idx];
+
+    const std::size_t size = readLe<uint32_t>(data.data() + offset);
+
+    if (data.size() - offset - 4 < size) throw corruptRecord(idx);
+
+    const char *ptr = data.data() + offset + 4;
+    const char *end = ptr + size;
+
+    // flags, termination, colors and results
+    if (end - ptr < 5) throw corruptRecord(idx);
+
+    Game game;
+    auto &match = game.match;
+
+    const uint8_t flags = readLe<uint8_t>(ptr);
+    match.termination   = static_cast<MatchTermination>(readLe<uint8_t>(ptr + 1));
+
+    auto &first  = match.players.first;
+    auto &second = match.players.second;
+
+    first.color   = chess::Color(static_cast<int8_t>(readLe<uint8_t>(ptr + 2)));
+    second.color  = first.color == chess::Color::NONE ? chess::Color::NONE : ~first.color;
+    first.result  = static_cast<chess::GameResult>(readLe<uint8_t>(ptr + 3));
+    second.result = static_cast<chess::GameResult>(readLe<uint8_t>(ptr + 4));
+    ptr += 5;
+
+    game.round_id = readVarint(ptr, end);
+    game.variant  = flags & FLAG_CHESS960 ? VariantType::FRC : VariantType::STANDARD;
+
+    first.config.variant  = game.variant;
+    second.config.variant = game.variant;
+
+    for (auto *str : {&game.event_name, &game.site, &first.config.name, &second.config.name,
+                      &match.date, &match.start_time, &match.end_time, &match.duration,
+                      &match.reason}) {
+        *str = readString(ptr, end);
+    }
+
+    first.config.limit.tc  = readTimeControl(ptr, end);
+    second.config.limit.tc = readTimeControl(ptr, end);
+
+    // the occupancy decides the size of the position
+    if (end - ptr < 8) throw corruptRecord(idx);
+
+    const auto position_size = BinBook::positionSize(std::string_view(ptr, end - ptr));
+
+    if (static_cast<std::size_t>(end - ptr) < position_size) throw corruptRecord(idx);
+
+    Opening start;
+    BinBook::decode(std::string_view(ptr, position_size), start);
+    match.fen = start.fen;
+    ptr += position_size;
+
+    const auto plies = readVarint(ptr, end);
+
+    match.moves.reserve(plies);
+
+    for (uint64_t i = 0; i < plies && ptr + 2 <= end; i++) {
+        const auto move = chess::Move(readLe<uint16_t>(ptr));
+        ptr += 2;
+
+        const auto score      = readVarint(ptr, end);
+        const auto kind       = static_cast<ScoreKind>(score & 3);
+        const auto value      = static_cast<int>(unzigzag(score >> 2));
+        const auto score_type = kind == CP_SCORE     ? ScoreType::CP
+                                : kind == MATE_SCORE ? ScoreType::MATE
+                                                     : ScoreType::ERR;
+
+        const auto depth    = static_cast<int>(readVarint(ptr, end));
+        const auto seldepth = static_cast<int>(readVarint(ptr, end));
+        const auto elapsed  = static_cast<int64_t>(readVarint(ptr, end));
+        const auto nodes    = readVarint(ptr, end);
+        const auto nps      = static_cast<int>(readVarint(ptr, end));
+
+        match.moves.emplace_back(chess::uci::moveToUci(move, game.variant == VariantType::FRC),
+                                 kind == NO_SCORE ? "0.00" : formatScore(score_type, value),
+                                 elapsed, depth, seldepth, value, 0);
+        match.moves.back().nodes = nodes;
+        match.moves.back().nps   = nps;
+    }
+
+    if (flags & FLAG_ILLEGAL && !match.moves.empty()) {
+        match.moves.back().move  = readString(ptr, end);
+        match.moves.back().legal = false;
+    }
+
+    return game;
+}
+
+std::size_t GameArchive::dump(const std::string &archive, const options::Pgn &pgn_options,
+                              const std::string &output) {
+    const GameArchive games(archive);
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+
+    if (!out) throw std::runtime_error("Could not open file: " + output);
+
+    for (std::size_t i = 0; i < games.size(); i++) {
+        const auto game = games[i];
+
+        options::Tournament tournament_options;
+        tournament_options.pgn        = pgn_options;
+        tournament_options.event_name = game.event_name;
+        tournament_options.site       = game.site;
+        tournament_options.variant    = game.variant;
+
+        out << PgnBuilder(game.match, tournament_options, game.round_id).get();
+    }
+
+    return games.size();
+}
+
+}  // namespace fast_chess
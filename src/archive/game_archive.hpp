@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <matchmaking/book/offset_index.hpp>
+#include <types/engine_config.hpp>
+#include <types/enums.hpp>
+#include <types/match_data.hpp>
+#include <types/tournament_options.hpp>
+#include <util/mapped_file.hpp>
+
+namespace fast_chess {
+
+/// @brief Packs finished games into a binary archive, which is a lot smaller than the pgn and
+/// can be read back without a pgn parser.
+///
+/// All numbers are little endian, varints use 7 bits per byte.
+///   header   "FCGA", u16 version
+///   record   u32 size of the rest of the record
+///            u8 flags, u8 termination, u8 color and u8 result of the first player,
+///            u8 result of the second player, varint round,
+///            event, site, both names, date, start time, end time, duration and reason, each
+///            as u8 length and bytes, the time control of both players as varints,
+///            the start position packed like a binary opening book entry, varint plies,
+///            per ply u16 move and varints of score, depth, seldepth, time, nodes and nps,
+///            the text of an illegal last move
+///
+/// Records are only ever appended, so several tournaments can continue the same archive. There is
+/// no index of the records in the file, the reader finds them by following their sizes, which
+/// only touches the first bytes of every record.
+class GameArchive {
+   public:
+    static constexpr uint16_t VERSION = 1;
+
+    /// @brief A game read back from the archive.
+    struct Game {
+        MatchData match;
+        std::size_t round_id = 0;
+
+        std::string event_name;
+        std::string site;
+        VariantType variant = VariantType::STANDARD;
+    };
+
+    /// @brief The bytes which start every archive.
+    /// @return
+    [[nodiscard]] static std::string header();
+
+    /// @brief Packs the game into a record.
+    /// @param match
+    /// @param tournament_options
+    /// @param round_id
+    /// @return
+    [[nodiscard]] static std::string encode(const MatchData &match,
+                                            const options::Tournament &tournament_options,
+                                            std::size_t round_id);
+
+    /// @brief Prepares the file for appending records. A new archive gets its header, an existing
+    /// one is cut off after its last complete record, so that a record which was interrupted while
+    /// writing does not shift all records appended after it. Throws if the file is not an archive.
+    /// @param file
+    static void prepareAppend(const std::string &file);
+
+    /// @brief Maps the archive and indexes its records, throws if it is not an archive. A record
+    /// which has not been written completely is ignored.
+    /// @param file
+    explicit GameArchive(const std::string &file);
+
+    [[nodiscard]] std::size_t size() const noexcept { return offsets_.size(); }
+
+    /// @brief Unpacks the game, throws if the record is corrupt.
+    /// @param idx
+    /// @return
+    [[nodiscard]] Game operator[](std::size_t idx) const;
+
+    /// @brief Writes all games of the archive to a pgn file.
+    /// @param archive
+    /// @param pgn_options notation and tracked fields of the pgn
+    /// @param output
+    /// @return the number of games written
+    static std::size_t dump(const std::string &archive, const options::Pgn &pgn_options,
+                            const std::string &output);
+
+   private:
+    /// @brief The end of the last complete record.
+    /// @return
+    [[nodiscard]] std::size_t completeSize() const noexcept;
+
+    MappedFile file_;
+    OffsetIndex offsets_;
+};
+
+}  // namespace fast_chess
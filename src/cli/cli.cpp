@@ -1,7 +1,10 @@
 #include <cli/cli.hpp>
 
 #include <filesystem>
+#include <string_view>
 
+#include <archive/game_archive.hpp>
+#include <matchmaking/book/bin_book.hpp>
 #include <matchmaking/output/output_factory.hpp>
 #include <matchmaking/result.hpp>
 #include <types/engine_config.hpp>
@@ -95,6 +98,23 @@ TimeControl parseTc(const std::string &tcString) {
     return tc;
 }
 
+CapturePolicy parseCapture(const std::string &value) {
+    CapturePolicy policy;
+
+    if (value == "all") {
+        policy.mode = CapturePolicy::Mode::ALL;
+    } else if (value == "scored") {
+        policy.mode = CapturePolicy::Mode::SCORED;
+    } else if (!value.empty() && value.find_first_not_of("0123456789") == std::string::npos) {
+        policy.mode  = CapturePolicy::Mode::LAST;
+        policy.lines = std::stoull(value);
+    } else {
+        OptionsParser::throwMissing("engine capture", "capture", value);
+    }
+
+    return policy;
+}
+
 bool isEngineSettableOption(std::string_view stringFormat) {
     return str_utils::startsWith(stringFormat, "option.");
 }
@@ -117,6 +137,8 @@ void parseEngineKeyValues(EngineConfiguration &engineConfig, const std::string &
         engineConfig.dir = value;
     else if (key == "args")
         engineConfig.args = value;
+    else if (key == "capture")
+        engineConfig.capture = parseCapture(value);
     else if (isEngineSettableOption(key)) {
         // Strip option.Name of the option. Part
         const std::size_t pos         = key.find('.');
@@ -150,6 +172,10 @@ void validateEnginePath(std::string dir, std::string &cmd) {
 void parseEngine(int &i, int argc, char const *argv[], ArgumentData &argument_data) {
     argument_data.configs.emplace_back();
 
+    for (const auto &[key, value] : argument_data.each) {
+        engine::parseEngineKeyValues(argument_data.configs.back(), key, value);
+    }
+
     parseDashOptions(i, argc, argv, [&](const std::string &key, const std::string &value) {
         engine::parseEngineKeyValues(argument_data.configs.back(), key, value);
     });
@@ -164,6 +190,8 @@ void parseEach(int &i, int argc, char const *argv[], ArgumentData &argument_data
         for (auto &config : argument_data.configs) {
             engine::parseEngineKeyValues(config, key, value);
         }
+
+        argument_data.each.emplace_back(key, value);
     });
 }
 
@@ -180,6 +208,12 @@ void parsePgnOut(int &i, int argc, char const *argv[], ArgumentData &argument_da
                 argument_data.tournament_options.pgn.track_seldepth = true;
             } else if (key == "nps") {
                 argument_data.tournament_options.pgn.track_nps = true;
+            } else if (key == "flushgames") {
+                argument_data.tournament_options.pgn.flush_games = std::stoi(value);
+            } else if (key == "flushtime") {
+                argument_data.tournament_options.pgn.flush_time = std::stod(value);
+            } else if (key == "fsync") {
+                argument_data.tournament_options.pgn.fsync = value == "true";
             } else if (key == "notation") {
                 if (value == "san") {
                     argument_data.tournament_options.pgn.notation = NotationType::SAN;
@@ -209,6 +243,8 @@ void parseOpening(int &i, int argc, char const *argv[], ArgumentData &argument_d
                 argument_data.tournament_options.opening.format = FormatType::EPD;
             } else if (str_utils::endsWith(value, ".pgn")) {
                 argument_data.tournament_options.opening.format = FormatType::PGN;
+            } else if (str_utils::endsWith(value, ".bin")) {
+                argument_data.tournament_options.opening.format = FormatType::BIN;
             }
 
             if (!std::filesystem::exists(value)) {
@@ -219,6 +255,8 @@ void parseOpening(int &i, int argc, char const *argv[], ArgumentData &argument_d
                 argument_data.tournament_options.opening.format = FormatType::EPD;
             } else if (value == "pgn") {
                 argument_data.tournament_options.opening.format = FormatType::PGN;
+            } else if (value == "bin") {
+                argument_data.tournament_options.opening.format = FormatType::BIN;
             } else {
                 OptionsParser::throwMissing("openings format", key, value);
             }
@@ -235,6 +273,130 @@ void parseOpening(int &i, int argc, char const *argv[], ArgumentData &argument_d
     });
 }
 
+/// @brief -convertbook file=book.pgn out=book.bin, writes the binary book and exits
+/// @param i
+/// @param argc
+/// @param argv
+void parseConvertBook(int &i, int argc, char const *argv[], ArgumentData &) {
+    std::string input, output;
+    FormatType format = FormatType::NONE;
+
+    parseDashOptions(i, argc, argv, [&](const std::string &key, const std::string &value) {
+        if (key == "file") {
+            input = value;
+
+            if (str_utils::endsWith(value, ".epd")) {
+                format = FormatType::EPD;
+            } else if (str_utils::endsWith(value, ".pgn")) {
+                format = FormatType::PGN;
+            }
+        } else if (key == "out") {
+            output = value;
+        } else if (key == "format") {
+            if (value == "epd") {
+                format = FormatType::EPD;
+            } else if (value == "pgn") {
+                format = FormatType::PGN;
+            } else {
+                OptionsParser::throwMissing("convertbook format", key, value);
+            }
+        } else {
+            OptionsParser::throwMissing("convertbook", key, value);
+        }
+    });
+
+    if (input.empty() || output.empty()) {
+        throw std::runtime_error("Error; -convertbook needs file=NAME and out=NAME");
+    }
+
+    const auto count = BinBook::convert(input, format, output);
+
+    std::cout << "Wrote " << count << " openings to " << output << std::endl;
+    std::exit(0);
+}
+
+void parseArchive(int &i, int argc, char const *argv[], ArgumentData &argument_data) {
+    parseDashOptions(i, argc, argv, [&](const std::string &key, const std::string &value) {
+        if (key == "file") {
+            argument_data.tournament_options.archive = value;
+        } else {
+            OptionsParser::throwMissing("archive", key, value);
+        }
+    });
+}
+
+void parseDatagen(int &i, int argc, char const *argv[], ArgumentData &argument_data) {
+    auto &datagen = argument_data.tournament_options.datagen;
+
+    parseDashOptions(i, argc, argv, [&](const std::string &key, const std::string &value) {
+        if (key == "file") {
+            datagen.file = value;
+        } else if (key == "format") {
+            if (value == "text") {
+                datagen.format = DatagenFormat::TEXT;
+            } else if (value == "bin") {
+                datagen.format = DatagenFormat::BIN;
+            } else {
+                OptionsParser::throwMissing("datagen format", key, value);
+            }
+        } else if (key == "minply") {
+            datagen.min_ply = std::stoi(value);
+        } else if (key == "skipchecks") {
+            datagen.skip_checks = value == "true";
+        } else if (key == "skipcaptures") {
+            datagen.skip_captures = value == "true";
+        } else if (key == "skipmates") {
+            datagen.skip_mates = value == "true";
+        } else {
+            OptionsParser::throwMissing("datagen", key, value);
+        }
+    });
+}
+
+/// @brief -dumparchive file=games.fcga out=games.pgn, writes the archived games as pgn and exits
+/// @param i
+/// @param argc
+/// @param argv
+void parseDumpArchive(int &i, int argc, char const *argv[], ArgumentData &) {
+    std::string input, output;
+    options::Pgn pgn;
+
+    parseDashOptions(i, argc, argv, [&](const std::string &key, const std::string &value) {
+        if (key == "file") {
+            input = value;
+        } else if (key == "out") {
+            output = value;
+        } else if (key == "nodes") {
+            pgn.track_nodes = true;
+        } else if (key == "seldepth") {
+            pgn.track_seldepth = true;
+        } else if (key == "nps") {
+            pgn.track_nps = true;
+        } else if (key == "notation") {
+            if (value == "san") {
+                pgn.notation = NotationType::SAN;
+            } else if (value == "lan") {
+                pgn.notation = NotationType::LAN;
+            } else if (value == "uci") {
+                pgn.notation = NotationType::UCI;
+            } else {
+                OptionsParser::throwMissing("dumparchive notation", key, value);
+            }
+        } else {
+            OptionsParser::throwMissing("dumparchive", key, value);
+        }
+    });
+
+    if (input.empty() || output.empty()) {
+        throw std::runtime_error("Error; -dumparchive needs file=NAME and out=NAME");
+    }
+
+    const auto count = GameArchive::dump(input, pgn, output);
+
+    std::cout << "Wrote " << count << " games to " << output << std::endl;
+    std::exit(0);
+}
+
 void parseSprt(int &i, int argc, char const *argv[], ArgumentData &argument_data) {
     parseDashOptions(i, argc, argv, [&](const std::string &key, const std::string &value) {
         if (argument_data.tournament_options.rounds == 0) {
@@ -249,6 +411,22 @@ void parseSprt(int &i, int argc, char const *argv[], ArgumentData &argument_data
             argument_data.tournament_options.sprt.alpha = std::stod(value);
         } else if (key == "beta") {
             argument_data.tournament_options.sprt.beta = std::stod(value);
+        } else if (key == "model") {
+            if (value == "trinomial") {
+                argument_data.tournament_options.sprt.model = SprtModel::TRINOMIAL;
+            } else if (value == "pentanomial") {
+                argument_data.tournament_options.sprt.model = SprtModel::PENTANOMIAL;
+            } else {
+                OptionsParser::throwMissing("sprt model", key, value);
+            }
+        } else if (key == "elotype") {
+            if (value == "logistic") {
+                argument_data.tournament_options.sprt.elo_type = EloType::LOGISTIC;
+            } else if (value == "normalized") {
+                argument_data.tournament_options.sprt.elo_type = EloType::NORMALIZED;
+            } else {
+                OptionsParser::throwMissing("sprt elotype", key, value);
+            }
         } else {
             OptionsParser::throwMissing("sprt", key, value);
         }
@@ -412,10 +590,51 @@ void parseVariant(int &i, int argc, char const *argv[], ArgumentData &argument_d
     if (val == "fischerandom") argument_data.tournament_options.variant = VariantType::FRC;
 }
 
-void parseTournament(int &i, int argc, char const *argv[], ArgumentData &) {
+void parseVerifyPv(int &i, int argc, char const *argv[], ArgumentData &argument_data) {
     std::string val;
-    // Do nothing
+
     parseValue(i, argc, argv, val);
+
+    if (val == "all") {
+        argument_data.tournament_options.verify_pv = PvVerificationType::ALL;
+    } else if (val == "last") {
+        argument_data.tournament_options.verify_pv = PvVerificationType::LAST;
+    } else if (val == "none") {
+        argument_data.tournament_options.verify_pv = PvVerificationType::NONE;
+    } else {
+        OptionsParser::throwMissing("verifypv", "verifypv", val);
+    }
+}
+
+void parseTournament(int &i, int argc, char const *argv[], ArgumentData &argument_data) {
+    std::string val;
+
+    parseValue(i, argc, argv, val);
+
+    if (val == "gauntlet") {
+        argument_data.tournament_options.type = TournamentType::GAUNTLET;
+    } else if (val == "swiss") {
+        argument_data.tournament_options.type = TournamentType::SWISS;
+    } else if (val == "roundrobin") {
+        argument_data.tournament_options.type = TournamentType::ROUNDROBIN;
+    } else {
+        OptionsParser::throwMissing("tournament", "tournament", val);
+    }
+}
+
+/// @brief -test weight=2, the options up to the next -test belong to this test
+/// @param i
+/// @param argc
+/// @param argv
+/// @param argument_data
+void parseTest(int &i, int argc, char const *argv[], ArgumentData &argument_data) {
+    parseDashOptions(i, argc, argv, [&](const std::string &key, const std::string &value) {
+        if (key == "weight") {
+            argument_data.tournament_options.weight = std::max(std::stoi(value), 1);
+        } else {
+            OptionsParser::throwMissing("test", key, value);
+        }
+    });
 }
 
 /// @brief .\fast-chess.exe -quick cmd=smallbrain.exe cmd=smallbrain-2.exe
@@ -472,6 +691,14 @@ void parseAffinity(int &, int, char const *[], ArgumentData &argument_data) {
     argument_data.tournament_options.affinity = false;
 }
 
+void parsePing(int &, int, char const *[], ArgumentData &argument_data) {
+    argument_data.tournament_options.ping = false;
+}
+
+void parseReactor(int &, int, char const *[], ArgumentData &argument_data) {
+    argument_data.tournament_options.reactor = true;
+}
+
 OptionsParser::OptionsParser(int argc, char const *argv[]) {
     if (argument_data_.tournament_options.output == OutputType::CUTECHESS) {
         argument_data_.tournament_options.ratinginterval = 1;
@@ -485,6 +712,10 @@ OptionsParser::OptionsParser(int argc, char const *argv[]) {
     addOption("each", parseEach);
     addOption("pgnout", parsePgnOut);
     addOption("openings", parseOpening);
+    addOption("convertbook", parseConvertBook);
+    addOption("archive", parseArchive);
+    addOption("dumparchive", parseDumpArchive);
+    addOption("datagen", parseDatagen);
     addOption("sprt", parseSprt);
     addOption("draw", parseDraw);
     addOption("resign", parseResign);
@@ -508,9 +739,13 @@ OptionsParser::OptionsParser(int argc, char const *argv[]) {
     addOption("recover", parseRecover);
     addOption("repeat", parseRepeat);
     addOption("variant", parseVariant);
+    addOption("verifypv", parseVerifyPv);
     addOption("tournament", parseTournament);
+    addOption("test", parseTest);
     addOption("quick", parseQuick);
     addOption("no-affinity", parseAffinity);
+    addOption("no-ping", parsePing);
+    addOption("reactor", parseReactor);
 
     parse(argc, argv);
 
@@ -520,4 +755,28 @@ OptionsParser::OptionsParser(int argc, char const *argv[]) {
     }
 }
 
+std::vector<std::vector<char const *>> OptionsParser::splitTests(int argc, char const *argv[]) {
+    std::vector<char const *> shared;
+    std::vector<std::vector<char const *>> tests;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::string_view(argv[i]) == "-test") tests.push_back({argv[0]});
+
+        (tests.empty() ? shared : tests.back()).push_back(argv[i]);
+    }
+
+    if (tests.empty()) return tests;
+
+    // config.json holds the options and results of a single tournament
+    for (int i = 1; i < argc; i++) {
+        if (std::string_view(argv[i]) == "-config") {
+            throw std::runtime_error("Error; -config cannot be used together with -test");
+        }
+    }
+
+    for (auto &test : tests) test.insert(test.begin() + 1, shared.begin(), shared.end());
+
+    return tests;
+}
+
 }  // namespace fast_chess::cli
\ No newline at end of file
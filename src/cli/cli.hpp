@@ -11,6 +11,7 @@
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <cli/man.hpp>
@@ -33,6 +34,9 @@ struct ArgumentData {
     std::vector<EngineConfiguration> configs;
 
     std::vector<EngineConfiguration> old_configs;
+
+    // Options of -each, also applied to the engines which follow it
+    std::vector<std::pair<std::string, std::string>> each;
 };
 
 class OptionsParser {
@@ -99,6 +103,15 @@ class OptionsParser {
 
     [[nodiscard]] stats_map getResults() const { return argument_data_.stats; }
 
+    /// @brief Splits the arguments at each -test option. The arguments before the first -test
+    /// are shared by all tests, they precede the arguments of each test so that a test can
+    /// override them. Throws if -config is combined with -test.
+    /// @param argc
+    /// @param argv
+    /// @return the arguments of each test starting with the program name, empty without -test
+    [[nodiscard]] static std::vector<std::vector<char const *>> splitTests(int argc,
+                                                                          char const *argv[]);
+
    private:
     /// @brief Adds an option to the parser
     /// @param optionName
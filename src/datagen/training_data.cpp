@@ -0,0 +1,67 @@
+#include <datagen/training_data.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <matchmaking/book/bin_book.hpp>
+#include <util/binary_io.hpp>
+
+namespace fast_chess {
+
+void TrainingData::add(const chess::Board &board, chess::Move move, const UciInfo &info,
+                       std::size_t ply) {
+    if (options_.file.empty() || ply < std::size_t(std::max(options_.min_ply, 0))) return;
+
+    if (info.score_type == ScoreType::ERR) return;
+    if (info.score_type == ScoreType::MATE && options_.skip_mates) return;
+    if (options_.skip_checks && board.inCheck()) return;
+    if (options_.skip_captures && board.isCapture(move)) return;
+
+    int score = info.score;
+
+    if (info.score_type == ScoreType::MATE) {
+        score = (score > 0 ? 1 : -1) * (MATE_SCORE - std::abs(score));
+    }
+
+    score = std::clamp(score, -MATE_SCORE, MATE_SCORE);
+
+    if (board.sideToMove() == chess::Color::BLACK) score = -score;
+
+    auto &position = positions_.emplace_back(Position{{}, score, static_cast<uint16_t>(ply)});
+
+    if (options_.format == DatagenFormat::BIN) {
+        BinBook::encode({board.getFen(), {}}, position.position);
+    } else {
+        position.position = board.getFen();
+    }
+}
+
+std::string TrainingData::get(const MatchData &match) const {
+    const auto &white =
+        match.players.first.color == chess::Color::WHITE ? match.players.first : match.players.second;
+
+    // 0 black wins, 1 draw, 2 white wins
+    const int result = white.result == chess::GameResult::WIN    ? 2
+                       : white.result == chess::GameResult::LOSE ? 0
+                                                                 : 1;
+
+    std::string out;
+
+    for (const auto &position : positions_) {
+        if (options_.format == DatagenFormat::BIN) {
+            out += position.position;
+            binary_io::writeLe<int16_t>(out, static_cast<int16_t>(position.score));
+            binary_io::writeLe<uint8_t>(out, static_cast<uint8_t>(result));
+            binary_io::writeLe<uint16_t>(out, position.ply);
+        } else {
+            out += position.position;
+            out += " | ";
+            out += std::to_string(position.score);
+            out += result == 2 ? " | 1.0\n" : result == 0 ? " | 0.0\n" : " | 0.5\n";
+        }
+    }
+
+    return out;
+}
+
+}  // namespace fast_chess
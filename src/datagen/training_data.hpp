@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <chess.hpp>
+
+#include <engines/uci_info.hpp>
+#include <types/engine_config.hpp>
+#include <types/match_data.hpp>
+#include <types/tournament_options.hpp>
+
+namespace fast_chess {
+
+/// @brief Collects the scored positions of a single game for network training. The positions are
+/// taken from the engine output while the game is played, the result is added once it is known.
+///
+/// Scores are in centipawns from white's point of view, mate scores are stored as 32000 minus
+/// the number of moves to mate.
+///   text     one position per line, "fen | score | result", result 1.0, 0.5 or 0.0 for white
+///   binary   the position packed like a binary opening book entry, i16 score,
+///            u8 result (0 black wins, 1 draw, 2 white wins), u16 ply, all little endian
+class TrainingData {
+   public:
+    static constexpr int MATE_SCORE = 32000;
+
+    explicit TrainingData(const options::Datagen &options) : options_(options) {}
+
+    /// @brief Drops the positions of the previous game.
+    void clear() noexcept { positions_.clear(); }
+
+    /// @brief Records the position before the move was played, unless the filters skip it.
+    /// @param board
+    /// @param move
+    /// @param info last info line of the engine which played the move
+    /// @param ply number of plies played before the position, opening moves included
+    void add(const chess::Board &board, chess::Move move, const UciInfo &info, std::size_t ply);
+
+    [[nodiscard]] std::size_t size() const noexcept { return positions_.size(); }
+
+    /// @brief Formats all recorded positions with the result of the game.
+    /// @param match
+    /// @return
+    [[nodiscard]] std::string get(const MatchData &match) const;
+
+   private:
+    struct Position {
+        std::string position;
+        int score;
+        uint16_t ply;
+    };
+
+    const options::Datagen &options_;
+    std::vector<Position> positions_;
+};
+
+}  // namespace fast_chess
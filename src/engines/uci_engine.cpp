@@ -2,6 +2,7 @@
 
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <util/helper.hpp>
@@ -17,6 +18,11 @@ bool UciEngine::isResponsive(std::chrono::milliseconds threshold) {
     return res == Process::Status::OK;
 }
 
+bool UciEngine::isAlive() {
+    skipped_pings_++;
+    return alive();
+}
+
 bool UciEngine::ucinewgame() {
     writeEngine("ucinewgame");
     return isResponsive(ping_time_);
@@ -28,7 +34,12 @@ bool UciEngine::uciok() { return readEngine("uciok") == Process::Status::OK; }
 
 void UciEngine::loadConfig(const EngineConfiguration &config) { config_ = config; }
 
-void UciEngine::quit() { writeEngine("quit"); }
+void UciEngine::quit() {
+    // nothing to tell an engine which already exited
+    if (!alive()) return;
+
+    writeEngine("quit");
+}
 
 void UciEngine::sendSetoption(const std::string &name, const std::string &value) {
     writeEngine("setoption name " + name + " value " + value);
@@ -37,6 +48,7 @@ void UciEngine::sendSetoption(const std::string &name, const std::string &value)
 void UciEngine::start() {
     Logger::log<Logger::Level::TRACE>("Starting engine", config_.name);
     init((config_.dir == "." ? "" : config_.dir) + config_.cmd, config_.args, config_.name);
+    setCapture(config_.capture);
     uci();
 
     if (!uciok()) {
@@ -75,7 +87,22 @@ void UciEngine::refreshUci() {
 Process::Status UciEngine::readEngine(std::string_view last_word,
                                       std::chrono::milliseconds threshold) {
     try {
-        return readProcess(output_, last_word, threshold);
+        last_info_  = UciInfo{};
+        info_lines_ = 0;
+
+        pv_arena_.clear();
+        pv_spans_.clear();
+
+        const auto status = readProcess(output_, last_word, threshold);
+
+        // the arena no longer grows, the views stay valid until the next read
+        pvs_.clear();
+
+        for (const auto &[offset, size] : pv_spans_) {
+            pvs_.emplace_back(pv_arena_.data() + offset, size);
+        }
+
+        return status;
     } catch (const std::exception &e) {
         Logger::log<Logger::Level::ERR>("Raised Exception in readProcess\nWarning; Engine",
                                         config_.name, "disconnects");
@@ -83,21 +110,35 @@ Process::Status UciEngine::readEngine(std::string_view last_word,
     }
 }
 
-std::string UciEngine::lastInfoLine() const {
-    // iterate backwards over the output and save the first line
-    // that contains "info depth" and score
-    for (auto it = output_.rbegin(); it != output_.rend(); ++it) {
-        if (it->find("info") != std::string::npos && it->find(" score ") != std::string::npos) {
-            return *it;
-        }
+void UciEngine::onLine(std::string_view line) {
+    if (!parseInfo(line, info_)) return;
+
+    info_lines_++;
+
+    if (collect_pvs_ && !info_.pv.empty()) {
+        pv_spans_.emplace_back(pv_arena_.size(), info_.pv.size());
+        pv_arena_.append(info_.pv);
     }
 
-    return {};
+    if (info_.score_type == ScoreType::ERR) return;
+
+    last_pv_.assign(info_.pv);
+
+    last_info_    = info_;
+    last_info_.pv = last_pv_;
 }
 
 void UciEngine::writeEngine(const std::string &input) {
+    // reuse the buffer instead of allocating the input plus newline
+    write_buffer_.assign(input);
+    write_buffer_ += '\n';
+
+    writeLine(write_buffer_);
+}
+
+void UciEngine::writeLine(const std::string &line) {
     try {
-        writeProcess(input + "\n");
+        writeProcess(line);
     } catch (const std::exception &e) {
         Logger::log<Logger::Level::ERR>("Raised Exception in writeProcess\nWarning; Engine",
                                         config_.name, "disconnects");
@@ -107,42 +148,28 @@ void UciEngine::writeEngine(const std::string &input) {
 }
 
 std::string UciEngine::bestmove() const {
-    const auto bm = str_utils::findElement<std::string>(str_utils::splitString(output_.back(), ' '),
-                                                        "bestmove");
-
-    if (!bm.has_value()) {
+    if (output_.empty()) {
         Logger::log<Logger::Level::WARN>("Warning; Could not extract bestmove.");
         return "aaaa";
     }
 
-    return bm.value();
-}
+    const auto bm = str_utils::findElement<std::string>(
+        str_utils::splitString(std::string(output_.back()), ' '), "bestmove");
 
-std::vector<std::string> UciEngine::lastInfo() const {
-    const auto last_info = lastInfoLine();
-    if (last_info.empty()) {
-        Logger::log<Logger::Level::WARN>("Warning; Could not extract last uci info line.");
-        return {};
+    if (!bm.has_value()) {
+        Logger::log<Logger::Level::WARN>("Warning; Could not extract bestmove.");
+        return "aaaa";
     }
 
-    return str_utils::splitString(last_info, ' ');
-}
-
-ScoreType UciEngine::lastScoreType() const {
-    auto score = str_utils::findElement<std::string>(lastInfo(), "score").value_or("ERR");
-
-    return score == "ERR" ? ScoreType::ERR : score == "cp" ? ScoreType::CP : ScoreType::MATE;
+    return bm.value();
 }
 
 int UciEngine::lastScore() const {
-    const auto score = lastScoreType();
-
-    if (score == ScoreType::ERR) {
+    if (last_info_.score_type == ScoreType::ERR) {
         Logger::log<Logger::Level::WARN>("Warning; Could not extract last uci score.");
         return 0;
     }
 
-    return str_utils::findElement<int>(lastInfo(), lastScoreType() == ScoreType::CP ? "cp" : "mate")
-        .value_or(0);
+    return last_info_.score;
 }
 }  // namespace fast_chess
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <chess.hpp>
@@ -11,12 +15,11 @@
 #include <process/process_posix.hpp>
 #endif
 
+#include <engines/uci_info.hpp>
 #include <types/engine_config.hpp>
 
 namespace fast_chess {
 
-enum class ScoreType { CP, MATE, ERR };
-
 class UciEngine : Process {
    public:
     explicit UciEngine(const EngineConfiguration &config) {
@@ -39,40 +42,73 @@ class UciEngine : Process {
     /// @return
     [[nodiscard]] bool isResponsive(std::chrono::milliseconds threshold = ping_time_);
 
+    /// @brief Checks that the engine process is still running without sending anything to it.
+    /// Used instead of isResponsive() when the engine is not pinged before every move, a hangup
+    /// of the engine is then reported by readEngine().
+    /// @return
+    [[nodiscard]] bool isAlive();
+
+    /// @brief Number of isready round trips which were skipped by isAlive(), over all engines.
+    /// @return
+    [[nodiscard]] static uint64_t skippedPings() noexcept { return skipped_pings_; }
+
     /// @brief Waits for the engine to output the last_word or until the threshold_ms is reached.
-    /// May throw if the read fails.
+    /// The info lines are parsed as they are read, before the capture policy drops any of them,
+    /// see lastInfo(). May throw if the read fails.
     /// @param last_word
     /// @param threshold 0 means no timeout
     /// @return
     Process::Status readEngine(std::string_view last_word,
                                std::chrono::milliseconds threshold = ping_time_);
 
-    [[nodiscard]] std::string lastInfoLine() const;
-
     /// @brief Writes the input to the engine. May throw if the write fails.
     /// @param input
     void writeEngine(const std::string &input);
 
+    /// @brief Writes a line which already ends with a newline, without copying it. May throw if
+    /// the write fails.
+    /// @param line
+    void writeLine(const std::string &line);
+
     void setCpus(const std::vector<int> &cpus) { setAffinity(cpus); }
 
+    using Process::peakOutputBytes;
+
     /// @brief Get the bestmove from the last output.
     /// @return
     [[nodiscard]] std::string bestmove() const;
 
-    /// @brief Get the last info from the last output.
+    /// @brief Get the last info with a score from the last output. The pv is only valid until the
+    /// next read.
     /// @return
-    [[nodiscard]] std::vector<std::string> lastInfo() const;
+    [[nodiscard]] const UciInfo &lastInfo() const noexcept { return last_info_; }
 
     /// @brief Get the last score type from the last output. cp or mate.
     /// @return
-    [[nodiscard]] ScoreType lastScoreType() const;
+    [[nodiscard]] ScoreType lastScoreType() const noexcept { return last_info_.score_type; }
 
     /// @brief Get the last score from the last output. Becareful, mate scores are not converted. So
     /// the score might 1, while it's actually mate 1. Always check lastScoreType() first.
     /// @return
     [[nodiscard]] int lastScore() const;
 
-    [[nodiscard]] const std::vector<std::string> &output() const noexcept { return output_; }
+    /// @brief Number of info lines of the last read, including the ones the capture policy dropped.
+    /// @return
+    [[nodiscard]] std::size_t infoLines() const noexcept { return info_lines_; }
+
+    /// @brief Collects the pv of every info line during the following reads, including the lines
+    /// which the capture policy drops.
+    /// @param collect
+    void collectPvs(bool collect) noexcept { collect_pvs_ = collect; }
+
+    /// @brief The pvs of the last read, only filled when collectPvs() is enabled. Valid until the
+    /// next read.
+    /// @return
+    [[nodiscard]] const std::vector<std::string_view> &pvs() const noexcept { return pvs_; }
+
+    /// @brief Output of the last read, valid until the next read.
+    /// @return
+    [[nodiscard]] const std::vector<std::string_view> &output() const noexcept { return output_; }
     [[nodiscard]] const EngineConfiguration &getConfig() const noexcept { return config_; }
 
     /// @brief TODO: expose this to the user
@@ -83,10 +119,32 @@ class UciEngine : Process {
     void start();
 
     void loadConfig(const EngineConfiguration &config);
+
+    void onLine(std::string_view line) override;
     void sendSetoption(const std::string &name, const std::string &value);
 
     EngineConfiguration config_;
 
-    std::vector<std::string> output_;
+    std::vector<std::string_view> output_;
+
+    /// @brief last info line with a score of the current read, parsed by onLine()
+    UciInfo last_info_;
+
+    /// @brief owns the pv of last_info_, the line itself may be dropped by the capture policy
+    std::string last_pv_;
+
+    /// @brief the line parsed by onLine()
+    UciInfo info_;
+    std::size_t info_lines_ = 0;
+
+    bool collect_pvs_ = false;
+    std::string pv_arena_;
+    std::vector<std::pair<std::size_t, std::size_t>> pv_spans_;
+    std::vector<std::string_view> pvs_;
+
+    /// @brief input plus newline, kept to avoid an allocation per write of a short command
+    std::string write_buffer_;
+
+    inline static std::atomic<uint64_t> skipped_pings_ = 0;
 };
 }  // namespace fast_chess
@@ -0,0 +1,135 @@
+#include <engines/uci_info.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+namespace fast_chess {
+
+namespace {
+
+/// @brief Removes the next space separated token from the line.
+/// @param line
+/// @return empty if there are no tokens left
+std::string_view nextToken(std::string_view &line) noexcept {
+    const auto begin = line.find_first_not_of(' ');
+
+    if (begin == std::string_view::npos) {
+        line = {};
+        return {};
+    }
+
+    line.remove_prefix(begin);
+
+    const auto end   = std::min(line.find(' '), line.size());
+    const auto token = line.substr(0, end);
+
+    line.remove_prefix(end);
+
+    return token;
+}
+
+/// @brief Parses the next token as a number, the value is left untouched if that fails.
+template <typename T>
+void parseNumber(std::string_view &line, T &value) noexcept {
+    const auto token = nextToken(line);
+    std::from_chars(token.data(), token.data() + token.size(), value);
+}
+
+}  // namespace
+
+bool parseInfo(std::string_view line, UciInfo &info) noexcept {
+    if (nextToken(line) != "info") return false;
+
+    info = UciInfo{};
+
+    while (!line.empty()) {
+        const auto token = nextToken(line);
+
+        if (token == "depth") {
+            parseNumber(line, info.depth);
+        } else if (token == "seldepth") {
+            parseNumber(line, info.seldepth);
+        } else if (token == "nodes") {
+            parseNumber(line, info.nodes);
+        } else if (token == "nps") {
+            parseNumber(line, info.nps);
+        } else if (token == "hashfull") {
+            parseNumber(line, info.hashfull);
+        } else if (token == "tbhits") {
+            parseNumber(line, info.tbhits);
+        } else if (token == "score") {
+            const auto type = nextToken(line);
+
+            if (type != "cp" && type != "mate") continue;
+
+            info.score_type = type == "cp" ? ScoreType::CP : ScoreType::MATE;
+            parseNumber(line, info.score);
+        } else if (token == "lowerbound") {
+            info.lowerbound = true;
+        } else if (token == "upperbound") {
+            info.upperbound = true;
+        } else if (token == "pv") {
+            // the pv ends at the first token which is not a move
+            const auto begin = line.find_first_not_of(' ');
+            if (begin == std::string_view::npos) break;
+
+            auto rest = line.substr(begin);
+            auto end  = rest;
+
+            while (!end.empty()) {
+                auto next = end;
+                if (!isUciMove(nextToken(next))) break;
+                end = next;
+            }
+
+            info.pv = rest.substr(0, rest.size() - end.size());
+            line    = end;
+        } else if (token == "string") {
+            // the remaining line is free text
+            break;
+        }
+    }
+
+    return true;
+}
+
+std::string formatScore(ScoreType type, int score) {
+    std::stringstream ss;
+
+    if (type == ScoreType::CP) {
+        ss << (score >= 0 ? '+' : '-');
+        ss << std::fixed << std::setprecision(2) << (float(std::abs(score)) / 100);
+    } else if (type == ScoreType::MATE) {
+        ss << (score > 0 ? "+M" : "-M") << std::to_string(std::abs(score));
+    } else {
+        ss << "ERR";
+    }
+
+    return ss.str();
+}
+
+bool isUciMove(std::string_view move) noexcept {
+    bool is_uci = false;
+
+    constexpr auto is_digit     = [](char c) { return c >= '0' && c <= '9'; };
+    constexpr auto is_file      = [](char c) { return c >= 'a' && c <= 'h'; };
+    constexpr auto is_promotion = [](char c) {
+        return c == 'n' || c == 'b' || c == 'r' || c == 'q';
+    };
+
+    // assert that the move is in uci format, [abcdefgh][0-9][abcdefgh][0-9][nbrq]
+    if (move.size() >= 4) {
+        is_uci = is_file(move[0]) && is_digit(move[1]) && is_file(move[2]) && is_digit(move[3]);
+    }
+
+    if (move.size() == 5) {
+        is_uci = is_uci && is_promotion(move[4]);
+    }
+
+    return is_uci;
+}
+
+}  // namespace fast_chess
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace fast_chess {
+
+enum class ScoreType { CP, MATE, ERR };
+
+/// @brief The fields of a uci "info" line. Fields which the engine did not send are 0.
+struct UciInfo {
+    int depth      = 0;
+    int seldepth   = 0;
+    uint64_t nodes = 0;
+    uint64_t nps   = 0;
+
+    ScoreType score_type = ScoreType::ERR;
+    /// @brief Becareful, mate scores are not converted, check score_type first.
+    int score       = 0;
+    bool lowerbound = false;
+    bool upperbound = false;
+
+    int hashfull    = 0;
+    uint64_t tbhits = 0;
+
+    /// @brief The moves after "pv", points into the line which was parsed.
+    std::string_view pv;
+};
+
+/// @brief Parses an info line in a single pass, without allocating.
+/// @param line
+/// @param info reset and filled with the fields of the line
+/// @return false if the line is not an info line
+[[nodiscard]] bool parseInfo(std::string_view line, UciInfo &info) noexcept;
+
+/// @brief Formats the score the way it is written to the pgn, +0.25 or -M3.
+/// @param type
+/// @param score
+/// @return "ERR" if the score is neither cp nor mate
+[[nodiscard]] std::string formatScore(ScoreType type, int score);
+
+/// @brief Checks that the move is in uci format, [abcdefgh][0-9][abcdefgh][0-9][nbrq]
+/// @param move
+/// @return
+[[nodiscard]] bool isUciMove(std::string_view move) noexcept;
+
+}  // namespace fast_chess
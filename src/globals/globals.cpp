@@ -64,7 +64,12 @@ void setCtrlCHandler() {
 #else
 void handler(int) { consoleHandlerAction(); }
 
-void setCtrlCHandler() { signal(SIGINT, handler); }
+void setCtrlCHandler() {
+    signal(SIGINT, handler);
+
+    // A write to an engine that exited must fail with EPIPE instead of killing fast-chess
+    signal(SIGPIPE, SIG_IGN);
+}
 #endif
 
 }  // namespace fast_chess
\ No newline at end of file
@@ -1,28 +1,65 @@
+#include <cstdlib>
+#include <exception>
 #include <thread>
 
 #include <cli/cli.hpp>
 #include <globals/globals.hpp>
+#include <matchmaking/tournament/scheduler/test_scheduler.hpp>
 #include <matchmaking/tournament/tournament_manager.hpp>
 
 using namespace fast_chess;
 
-int main(int argc, char const *argv[]) {
-    setCtrlCHandler();
+namespace {
 
+void run(int argc, char const *argv[]) {
     Logger::log<Logger::Level::TRACE>("Reading options...");
+
+    if (const auto arguments = cli::OptionsParser::splitTests(argc, argv); !arguments.empty()) {
+        std::vector<TestScheduler::Test> tests;
+
+        for (auto args : arguments) {
+            const auto options = cli::OptionsParser(int(args.size()), args.data());
+            tests.push_back({options.getGameOptions(), options.getEngineConfigs()});
+        }
+
+        Logger::log<Logger::Level::TRACE>("Creating tests...");
+        auto scheduler = TestScheduler(tests);
+
+        scheduler.start();
+
+        Logger::log<Logger::Level::INFO>("Finished all tests.");
+
+        return;
+    }
+
     auto options = cli::OptionsParser(argc, argv);
 
-    {
-        Logger::log<Logger::Level::TRACE>("Creating tournament...");
-        auto tour = TournamentManager(options.getGameOptions(), options.getEngineConfigs());
+    Logger::log<Logger::Level::TRACE>("Creating tournament...");
+    auto tour = TournamentManager(options.getGameOptions(), options.getEngineConfigs());
+
+    Logger::log<Logger::Level::TRACE>("Setting results...");
+    tour.tournament()->setResults(options.getResults());
+
+    Logger::log<Logger::Level::TRACE>("Starting tournament...");
+    tour.start();
+
+    Logger::log<Logger::Level::INFO>("Finished tournament.");
+}
+
+}  // namespace
+
+int main(int argc, char const *argv[]) {
+    setCtrlCHandler();
 
-        Logger::log<Logger::Level::TRACE>("Setting results...");
-        tour.roundRobin()->setResults(options.getResults());
+    try {
+        run(argc, argv);
+    } catch (const std::exception &e) {
+        // invalid options and output files which can not be opened end up here
+        Logger::log<Logger::Level::FATAL>(e.what());
 
-        Logger::log<Logger::Level::TRACE>("Starting tournament...");
-        tour.start();
+        stopProcesses();
 
-        Logger::log<Logger::Level::INFO>("Finished tournament.");
+        return EXIT_FAILURE;
     }
 
     stopProcesses();
@@ -0,0 +1,395 @@
+#include <matchmaking/book/bin_book.hpp>
+
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <matchmaking/book/epd_book.hpp>
+#include <util/binary_io.hpp>
+
+namespace fast_chess {
+
+using binary_io::readLe;
+using binary_io::writeLe;
+
+namespace {
+
+constexpr char MAGIC[4]             = {'F', 'C', 'B', 'K'};
+constexpr std::size_t HEADER_SIZE   = 24;
+constexpr std::string_view PIECES   = "PNBRQKpnbrqk";
+constexpr uint8_t WHITE_CASTLE_ROOK = 12;
+constexpr uint8_t BLACK_CASTLE_ROOK = 13;
+constexpr int8_t NO_PIECE           = -1;
+
+constexpr uint8_t FLAG_BLACK     = 1;
+constexpr uint8_t FLAG_ENPASSANT = 2;
+
+/// @brief Splits off the next space separated field of the fen.
+[[nodiscard]] std::string_view nextField(std::string_view &fen) noexcept {
+    while (!fen.empty() && fen.front() == ' ') fen.remove_prefix(1);
+
+    const auto field = fen.substr(0, fen.find(' '));
+    fen.remove_prefix(field.size());
+
+    return field;
+}
+
+template <typename T>
+[[nodiscard]] T parseNumber(std::string_view field, T fallback) noexcept {
+    T value;
+    const auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+    return ec == std::errc() ? value : fallback;
+}
+
+template <typename T>
+void appendNumber(std::string &out, T value) {
+    char buffer[8];
+    const auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, ptr);
+}
+
+[[nodiscard]] std::runtime_error invalidFen(const std::string &fen) {
+    return std::runtime_error("Invalid fen in opening book: " + fen);
+}
+
+}  // namespace
+
+BinBook::BinBook(const std::string &file) : file_(file) {
+    const auto data = file_.view();
+
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a binary opening book: " + file);
+    }
+
+    if (readLe<uint16_t>(data.data() + 4) != VERSION) {
+        throw std::runtime_error("Unsupported binary opening book version: " + file);
+    }
+
+    offset_size_ = readLe<uint16_t>(data.data() + 6);
+    count_       = readLe<uint64_t>(data.data() + 8);
+    table_       = readLe<uint64_t>(data.data() + 16);
+
+    if ((offset_size_ != 4 && offset_size_ != 8) || table_ > data.size() ||
+        (data.size() - table_) / offset_size_ < count_ + 1) {
+        throw std::runtime_error("Corrupt binary opening book: " + file);
+    }
+}
+
+std::size_t BinBook::offset(std::size_t idx) const noexcept {
+    const char *entry = file_.view().data() + table_ + idx * offset_size_;
+    return offset_size_ == 4 ? readLe<uint32_t>(entry) : readLe<uint64_t>(entry);
+}
+
+void BinBook::get(std::size_t idx, Opening &opening) const {
+    const auto begin = offset(idx);
+    const auto end   = offset(idx + 1);
+
+    // the entries lie between the header and the offset table
+    if (begin < HEADER_SIZE || begin > end || end > table_) {
+        throw std::runtime_error("Corrupt offset of entry " + std::to_string(idx) +
+                                 " in binary opening book");
+    }
+
+    decode(file_.view().substr(begin, end - begin), opening);
+}
+
+void BinBook::encode(const Opening &opening, std::string &out) {
+    std::string_view fen = opening.fen;
+
+    const auto placement = nextField(fen);
+    const auto stm       = nextField(fen);
+    const auto castling  = nextField(fen);
+    const auto enpassant = nextField(fen);
+    const auto halfmove  = nextField(fen);
+    const auto fullmove  = nextField(fen);
+
+    std::array<int8_t, 64> board;
+    board.fill(NO_PIECE);
+
+    int square = 56;
+
+    for (const char c : placement) {
+        if (c == '/') {
+            square -= 16;
+        } else if (c >= '1' && c <= '8') {
+            square += c - '0';
+        } else {
+            const auto piece = PIECES.find(c);
+
+            if (piece == std::string_view::npos || square < 0 || square >= 64) {
+                throw invalidFen(opening.fen);
+            }
+
+            board[square++] = static_cast<int8_t>(piece);
+        }
+    }
+
+    // mark the rooks which can castle, KQkq refer to the outermost rook
+    for (const char c : castling) {
+        if (c == '-') break;
+
+        const bool white  = std::isupper(static_cast<unsigned char>(c));
+        const int rank    = white ? 0 : 56;
+        const int8_t rook = white ? 3 : 9;
+        const int8_t king = white ? 5 : 11;
+
+        int king_file = 0;
+        while (king_file < 8 && board[rank + king_file] != king) king_file++;
+
+        const char lower = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+        int file = -1;
+
+        if (lower == 'k') {
+            for (int f = 7; f > king_file && file == -1; f--) {
+                if (board[rank + f] == rook) file = f;
+            }
+        } else if (lower == 'q') {
+            for (int f = 0; f < king_file && file == -1; f++) {
+                if (board[rank + f] == rook) file = f;
+            }
+        } else if (lower >= 'a' && lower <= 'h' && board[rank + lower - 'a'] == rook) {
+            file = lower - 'a';
+        }
+
+        if (king_file == 8 || file == -1) throw invalidFen(opening.fen);
+
+        board[rank + file] = white ? WHITE_CASTLE_ROOK : BLACK_CASTLE_ROOK;
+    }
+
+    uint8_t flags = stm == "b" ? FLAG_BLACK : 0;
+
+    if (enpassant.size() == 2 && enpassant[0] >= 'a' && enpassant[0] <= 'h') {
+        flags |= FLAG_ENPASSANT | ((enpassant[0] - 'a') << 2);
+    }
+
+    uint64_t occupancy = 0;
+    for (int sq = 0; sq < 64; sq++) {
+        if (board[sq] != NO_PIECE) occupancy |= 1ull << sq;
+    }
+
+    writeLe(out, occupancy);
+
+    // two pieces per byte, the first one in the low nibble
+    int pending = -1;
+    for (int sq = 0; sq < 64; sq++) {
+        if (board[sq] == NO_PIECE) continue;
+
+        if (pending == -1) {
+            pending = board[sq];
+        } else {
+            out += static_cast<char>(pending | (board[sq] << 4));
+            pending = -1;
+        }
+    }
+
+    if (pending != -1) out += static_cast<char>(pending);
+
+    const auto clock = parseNumber<unsigned>(halfmove, 0);
+
+    writeLe(out, flags);
+    writeLe(out, static_cast<uint8_t>(std::min(clock, 255u)));
+    writeLe(out, parseNumber<uint16_t>(fullmove, 1));
+
+    for (const auto move : opening.moves) writeLe(out, move.move());
+}
+
+std::size_t BinBook::positionSize(std::string_view entry) noexcept {
+    const auto pieces = chess::Bitboard(readLe<uint64_t>(entry.data())).count();
+
+    // occupancy, the piece codes, flags, halfmove clock and fullmove number
+    return 8 + (pieces + 1) / 2 + 4;
+}
+
+void BinBook::decode(std::string_view entry, Opening &opening) {
+    if (entry.size() < 8 || entry.size() < positionSize(entry)) {
+        throw std::runtime_error("Truncated entry in binary opening book: " +
+                                 std::to_string(entry.size()) + " bytes");
+    }
+
+    const char *data         = entry.data();
+    const uint64_t occupancy = readLe<uint64_t>(data);
+    const auto pieces        = chess::Bitboard(occupancy).count();
+
+    const char *nibbles = data + 8;
+    const char *tail    = nibbles + (pieces + 1) / 2;
+
+    const uint8_t flags     = readLe<uint8_t>(tail);
+    const uint8_t halfmove  = readLe<uint8_t>(tail + 1);
+    const uint16_t fullmove = readLe<uint16_t>(tail + 2);
+
+    const char *moves       = data + positionSize(entry);
+    const std::size_t count = (data + entry.size() - moves) / 2;
+
+    std::array<int8_t, 64> board;
+    board.fill(NO_PIECE);
+
+    for (int sq = 0, i = 0; sq < 64; sq++) {
+        if (!(occupancy & (1ull << sq))) continue;
+
+        const auto byte = static_cast<unsigned char>(nibbles[i / 2]);
+        const auto code = i % 2 == 0 ? byte & 0xf : byte >> 4;
+        i++;
+
+        // 14 and 15 are not used, a corrupt entry must not index past the pieces
+        if (code > BLACK_CASTLE_ROOK) {
+            throw std::runtime_error("Invalid piece code in binary opening book: " +
+                                     std::to_string(code));
+        }
+
+        board[sq] = static_cast<int8_t>(code);
+    }
+
+    auto &fen = opening.fen;
+    fen.clear();
+
+    for (int rank = 7; rank >= 0; rank--) {
+        int empty = 0;
+
+        for (int file = 0; file < 8; file++) {
+            const auto piece = board[rank * 8 + file];
+
+            if (piece == NO_PIECE) {
+                empty++;
+                continue;
+            }
+
+            if (empty > 0) fen += static_cast<char>('0' + empty);
+            empty = 0;
+
+            if (piece == WHITE_CASTLE_ROOK) {
+                fen += 'R';
+            } else if (piece == BLACK_CASTLE_ROOK) {
+                fen += 'r';
+            } else {
+                fen += PIECES[piece];
+            }
+        }
+
+        if (empty > 0) fen += static_cast<char>('0' + empty);
+        if (rank > 0) fen += '/';
+    }
+
+    const bool black = flags & FLAG_BLACK;
+
+    fen += black ? " b " : " w ";
+
+    // standard positions use KQkq, everything else the files of the rooks
+    const auto castling_size = fen.size();
+
+    for (const bool white : {true, false}) {
+        const int rank    = white ? 0 : 56;
+        const int8_t king = white ? 5 : 11;
+        const int8_t rook = white ? WHITE_CASTLE_ROOK : BLACK_CASTLE_ROOK;
+
+        int king_file = 0;
+        while (king_file < 8 && board[rank + king_file] != king) king_file++;
+
+        for (int file = 7; file >= 0; file--) {
+            if (board[rank + file] != rook) continue;
+
+            char c = static_cast<char>('a' + file);
+
+            if (king_file == 4 && file == 7) c = 'k';
+            if (king_file == 4 && file == 0) c = 'q';
+
+            fen += white ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+        }
+    }
+
+    if (fen.size() == castling_size) fen += '-';
+
+    if (flags & FLAG_ENPASSANT) {
+        fen += ' ';
+        fen += static_cast<char>('a' + ((flags >> 2) & 7));
+        fen += black ? '3' : '6';
+    } else {
+        fen += " -";
+    }
+
+    fen += ' ';
+    appendNumber(fen, halfmove);
+    fen += ' ';
+    appendNumber(fen, fullmove);
+
+    opening.moves.clear();
+    for (std::size_t i = 0; i < count; i++) {
+        opening.moves.emplace_back(readLe<uint16_t>(moves + 2 * i));
+    }
+
+    opening.stm = black == (count % 2 == 0) ? chess::Color::BLACK : chess::Color::WHITE;
+}
+
+std::size_t BinBook::convert(const std::string &input, FormatType format,
+                             const std::string &output) {
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+
+    if (!out) throw std::runtime_error("Could not open file: " + output);
+
+    std::string entry(HEADER_SIZE, '\0');
+    out.write(entry.data(), entry.size());
+
+    std::vector<uint64_t> offsets;
+    uint64_t position = HEADER_SIZE;
+
+    const auto add = [&](const Opening &opening) {
+        entry.clear();
+        encode(opening, entry);
+
+        offsets.push_back(position);
+        out.write(entry.data(), entry.size());
+        position += entry.size();
+    };
+
+    if (format == FormatType::EPD) {
+        const EpdBook book(input);
+
+        offsets.reserve(book.size() + 1);
+
+        Opening opening;
+        for (std::size_t i = 0; i < book.size(); i++) {
+            opening.fen = book[i];
+            add(opening);
+        }
+    } else if (format == FormatType::PGN) {
+        for (const auto &opening : PgnReader(input).getOpenings()) add(opening);
+    } else {
+        throw std::runtime_error("Only EPD and PGN books can be converted: " + input);
+    }
+
+    offsets.push_back(position);
+
+    const uint16_t offset_size = position <= std::numeric_limits<uint32_t>::max() ? 4 : 8;
+
+    entry.clear();
+    for (const auto offset : offsets) {
+        if (offset_size == 4) {
+            writeLe(entry, static_cast<uint32_t>(offset));
+        } else {
+            writeLe(entry, offset);
+        }
+    }
+
+    out.write(entry.data(), entry.size());
+
+    entry.assign(MAGIC, sizeof(MAGIC));
+    writeLe(entry, VERSION);
+    writeLe(entry, offset_size);
+    writeLe(entry, static_cast<uint64_t>(offsets.size() - 1));
+    writeLe(entry, position);
+
+    out.seekp(0);
+    out.write(entry.data(), entry.size());
+
+    if (!out) throw std::runtime_error("Failed to write the binary opening book: " + output);
+
+    return offsets.size() - 1;
+}
+
+}  // namespace fast_chess
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <pgn/pgn_reader.hpp>
+#include <types/enums.hpp>
+#include <util/mapped_file.hpp>
+
+namespace fast_chess {
+
+/// @brief A packed opening book which is memory mapped. Loading only checks the header, fetching
+/// decodes one entry into an existing opening.
+///
+/// All numbers are little endian.
+///   header   "FCBK", u16 version, u16 offset size (4 or 8), u64 entries, u64 table offset
+///   entry    u64 occupancy, 4 bit piece codes of the occupied squares from a1 to h8,
+///            u8 flags, u8 halfmove clock, u16 fullmove number, u16 moves until the entry ends
+///   table    entries + 1 offsets, entry i spans [offset i, offset i + 1)
+///
+/// Rooks which can castle have a piece code of their own, so chess960 castling rights need no
+/// extra space. The flags hold the side to move and the file of the en passant square.
+class BinBook {
+   public:
+    static constexpr uint16_t VERSION = 1;
+
+    BinBook() = default;
+
+    /// @brief Maps the file and checks its header, throws if it is not a binary book.
+    /// @param file
+    explicit BinBook(const std::string &file);
+
+    [[nodiscard]] std::size_t size() const noexcept { return count_; }
+    [[nodiscard]] bool empty() const noexcept { return count_ == 0; }
+
+    /// @brief Decodes the entry, the fen and moves reuse the storage of the opening. Throws if
+    /// the offsets of the entry are corrupt.
+    /// @param idx
+    /// @param opening
+    void get(std::size_t idx, Opening &opening) const;
+
+    /// @brief Appends the packed opening to out.
+    /// @param opening
+    /// @param out
+    static void encode(const Opening &opening, std::string &out);
+
+    /// @brief The size of the packed position at the start of an entry, the moves follow it.
+    /// @param entry has to hold at least the occupancy
+    /// @return
+    [[nodiscard]] static std::size_t positionSize(std::string_view entry) noexcept;
+
+    /// @brief Unpacks a single entry, throws if it is shorter than its packed position.
+    /// @param entry
+    /// @param opening
+    static void decode(std::string_view entry, Opening &opening);
+
+    /// @brief Writes all openings of an EPD or PGN book to a binary book.
+    /// @param input
+    /// @param format
+    /// @param output
+    /// @return the number of openings written
+    static std::size_t convert(const std::string &input, FormatType format,
+                               const std::string &output);
+
+   private:
+    [[nodiscard]] std::size_t offset(std::size_t idx) const noexcept;
+
+    MappedFile file_;
+
+    std::size_t count_       = 0;
+    std::size_t table_       = 0;
+    std::size_t offset_size_ = 4;
+};
+
+}  // namespace fast_chess
@@ -0,0 +1,44 @@
+#include <matchmaking/book/epd_book.hpp>
+
+#include <cstring>
+
+namespace fast_chess {
+
+EpdBook::EpdBook(const std::string &file) : file_(file) {
+    const auto data = file_.view();
+
+    offsets_ = OffsetIndex(data.size());
+
+    // a fen is roughly 60 bytes, avoid most reallocations
+    offsets_.reserve(data.size() / 64);
+
+    const char *begin = data.data();
+    const char *end   = data.data() + data.size();
+
+    for (const char *line = begin; line < end;) {
+        const auto *newline  = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        const auto *line_end = newline == nullptr ? end : newline;
+
+        // skip empty lines, including the \r of windows line endings
+        if (line_end - line > 1 || (line_end - line == 1 && *line != '\r')) {
+            offsets_.push_back(line - begin);
+        }
+
+        line = line_end + 1;
+    }
+
+    offsets_.shrink_to_fit();
+}
+
+std::string_view EpdBook::operator[](std::size_t idx) const noexcept {
+    const auto data   = file_.view();
+    const auto offset = offsets_[idx];
+
+    auto line = data.substr(offset, data.find('\n', offset) - offset);
+
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+    return line;
+}
+
+}  // namespace fast_chess
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <matchmaking/book/offset_index.hpp>
+#include <util/mapped_file.hpp>
+
+namespace fast_chess {
+
+/// @brief An EPD book which is memory mapped instead of read into strings. Only the offset of
+/// every line is kept.
+class EpdBook {
+   public:
+    EpdBook() = default;
+
+    /// @brief Maps the file and indexes its non empty lines.
+    /// @param file
+    explicit EpdBook(const std::string &file);
+
+    [[nodiscard]] std::size_t size() const noexcept { return offsets_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return offsets_.empty(); }
+
+    /// @brief The line without its line ending, valid as long as the book exists.
+    /// @param idx
+    /// @return
+    [[nodiscard]] std::string_view operator[](std::size_t idx) const noexcept;
+
+   private:
+    MappedFile file_;
+    OffsetIndex offsets_;
+};
+
+}  // namespace fast_chess
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace fast_chess {
+
+/// @brief Byte offsets into a file. Each offset takes 4 bytes for files smaller than 4 GiB and 8
+/// bytes otherwise.
+class OffsetIndex {
+   public:
+    OffsetIndex() = default;
+
+    /// @brief
+    /// @param file_size size of the file the offsets point into
+    explicit OffsetIndex(std::size_t file_size) {
+        if (file_size > std::numeric_limits<uint32_t>::max()) offsets_ = std::vector<uint64_t>();
+    }
+
+    void reserve(std::size_t n) {
+        std::visit([n](auto &offsets) { offsets.reserve(n); }, offsets_);
+    }
+
+    void push_back(std::size_t offset) {
+        std::visit(
+            [offset](auto &offsets) {
+                using T = typename std::decay_t<decltype(offsets)>::value_type;
+                offsets.push_back(static_cast<T>(offset));
+            },
+            offsets_);
+    }
+
+    void shrink_to_fit() {
+        std::visit([](auto &offsets) { offsets.shrink_to_fit(); }, offsets_);
+    }
+
+    [[nodiscard]] std::size_t operator[](std::size_t idx) const noexcept {
+        return std::visit([idx](const auto &offsets) -> std::size_t { return offsets[idx]; },
+                          offsets_);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return std::visit([](const auto &offsets) { return offsets.size(); }, offsets_);
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+   private:
+    std::variant<std::vector<uint32_t>, std::vector<uint64_t>> offsets_;
+};
+
+}  // namespace fast_chess
@@ -1,15 +1,20 @@
 #include <matchmaking/book/opening_book.hpp>
 
-#include <fstream>
 #include <string>
-
-#include <util/safe_getline.hpp>
+#include <string_view>
 
 namespace fast_chess {
 
-OpeningBook::OpeningBook(const options::Opening& opening) {
-    start_ = opening.start;
+OpeningBook::OpeningBook(const options::Opening& opening, uint64_t seed, VariantType variant) {
+    start_    = opening.start;
+    chess960_ = variant == VariantType::FRC;
+
     setup(opening.file, opening.format);
+
+    if (opening.order == OrderType::RANDOM) {
+        const auto size = std::visit([](const auto& book) { return book.size(); }, book_);
+        order_          = IndexPermutation(size, seed);
+    }
 }
 
 void OpeningBook::setup(const std::string& file, FormatType type) {
@@ -18,51 +23,93 @@ void OpeningBook::setup(const std::string& file, FormatType type) {
     }
 
     if (type == FormatType::PGN) {
-        book_ = PgnReader(file).getOpenings();
+        book_ = PgnBook(file);
 
         if (std::get<pgn_book>(book_).empty()) {
             throw std::runtime_error("No openings found in PGN file: " + file);
         }
     } else if (type == FormatType::EPD) {
-        std::ifstream openingFile;
-        openingFile.open(file);
-
-        std::string line;
-        std::vector<std::string> epd;
-
-        while (safeGetline(openingFile, line)) {
-            epd.emplace_back(line);
-        }
-
-        openingFile.close();
-
-        book_ = epd;
+        book_ = EpdBook(file);
 
         if (std::get<epd_book>(book_).empty()) {
             throw std::runtime_error("No openings found in EPD file: " + file);
         }
+    } else if (type == FormatType::BIN) {
+        book_ = BinBook(file);
+
+        if (std::get<bin_book>(book_).empty()) {
+            throw std::runtime_error("No openings found in binary book: " + file);
+        }
     }
 }
 
-Opening OpeningBook::fetch() noexcept {
-    static uint64_t opening_index = 0;
-    const auto idx                = start_ + opening_index++;
-    const auto book_size          = std::holds_alternative<epd_book>(book_)
-                                        ? std::get<epd_book>(book_).size()
-                                        : std::get<pgn_book>(book_).size();
+Opening OpeningBook::fetch() {
+    Opening opening;
+    fetch(opening);
+    return opening;
+}
+
+void OpeningBook::fetch(Opening& opening) {
+    const auto idx       = start_ + fetched_++;
+    const auto book_size = std::visit([](const auto& book) { return book.size(); }, book_);
 
     if (book_size == 0) {
-        return {chess::constants::STARTPOS, {}};
+        opening = {chess::constants::STARTPOS, {}};
+        return;
     }
 
+    const auto pos = order_ ? (*order_)(idx % book_size) : idx % book_size;
+
     if (std::holds_alternative<epd_book>(book_)) {
-        const auto fen = std::get<epd_book>(book_)[idx % std::get<epd_book>(book_).size()];
-        return {fen, {}, chess::Board(fen).sideToMove()};
+        const auto fen = std::get<epd_book>(book_)[pos];
+
+        // the side to move is the second field, no need to set up a board for it
+        const auto stm_pos = fen.find(' ');
+        const bool black = stm_pos != std::string_view::npos && fen.substr(stm_pos + 1, 1) == "b";
+
+        opening.fen = fen;
+        opening.moves.clear();
+        opening.stm = black ? chess::Color::BLACK : chess::Color::WHITE;
     } else if (std::holds_alternative<pgn_book>(book_)) {
-        return std::get<pgn_book>(book_)[idx % std::get<pgn_book>(book_).size()];
+        opening = std::get<pgn_book>(book_)[pos];
+    } else if (std::holds_alternative<bin_book>(book_)) {
+        std::get<bin_book>(book_).get(pos, opening);
+    }
+
+    // both games of a round start from this opening, only play the moves once. Without moves
+    // the games just set up the fen, that is cheaper than sharing a board.
+    if (opening.moves.empty()) {
+        opening.prepared.reset();
+    } else {
+        opening.prepared = prepare(opening, chess960_);
+    }
+}
+
+std::shared_ptr<const PreparedOpening> OpeningBook::prepare(const Opening& opening, bool chess960) {
+    auto prepared = std::make_shared<PreparedOpening>();
+
+    auto& board = prepared->board;
+
+    prepared->start    = startPosition(board, opening, chess960);
+    prepared->chess960 = chess960;
+
+    prepared->moves.reserve(opening.moves.size());
+
+    for (const auto& move : opening.moves) {
+        prepared->moves.push_back(chess::uci::moveToUci(move, chess960));
+        board.makeMove(move);
     }
 
-    return {chess::constants::STARTPOS, {}};
+    return prepared;
+}
+
+std::string OpeningBook::startPosition(chess::Board& board, const Opening& opening,
+                                       bool chess960) {
+    board.set960(chess960);
+    board.setFen(opening.fen);
+
+    const auto fen = board.getFen();
+    return fen == chess::constants::STARTPOS ? "startpos" : fen;
 }
 
-}  // namespace fast_chess
\ No newline at end of file
+}  // namespace fast_chess
@@ -1,43 +1,71 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
 #include <variant>
 #include <vector>
 
+#include <matchmaking/book/bin_book.hpp>
+#include <matchmaking/book/epd_book.hpp>
+#include <matchmaking/book/pgn_book.hpp>
 #include <pgn/pgn_reader.hpp>
 #include <types/enums.hpp>
 #include <types/tournament_options.hpp>
-#include <util/rand.hpp>
+#include <util/permutation.hpp>
 
 namespace fast_chess {
 
 class OpeningBook {
    public:
     OpeningBook() = default;
-    explicit OpeningBook(const options::Opening& opening);
 
-    /// @brief Fisher-Yates / Knuth shuffle
-    void shuffle() noexcept {
-        constexpr auto shuffle = [](auto& vec) {
-            for (std::size_t i = 0; i + 2 <= vec.size(); i++) {
-                std::size_t j = i + (random::mersenne_rand() % (vec.size() - i));
-                std::swap(vec[i], vec[j]);
-            }
-        };
+    /// @brief
+    /// @param opening
+    /// @param seed decides the order of a random book
+    /// @param variant
+    explicit OpeningBook(const options::Opening& opening, uint64_t seed = 0,
+                         VariantType variant = VariantType::STANDARD);
 
-        std::visit(shuffle, book_);
-    }
+    [[nodiscard]] Opening fetch();
 
-    [[nodiscard]] Opening fetch() noexcept;
+    /// @brief Fetches the next opening into an existing one. Binary books reuse its storage.
+    /// @param opening
+    void fetch(Opening& opening);
+
+    /// @brief Plays the opening moves on a board and converts them to uci.
+    /// @param opening
+    /// @param chess960
+    /// @return
+    [[nodiscard]] static std::shared_ptr<const PreparedOpening> prepare(const Opening& opening,
+                                                                        bool chess960);
+
+    /// @brief Sets the board to the fen of the opening, without playing its moves.
+    /// @param board
+    /// @param opening
+    /// @param chess960
+    /// @return the position for the uci position command, "startpos" or the fen
+    [[nodiscard]] static std::string startPosition(chess::Board& board, const Opening& opening,
+                                                   bool chess960);
 
    private:
     void setup(const std::string& file, FormatType type);
 
-    using epd_book = std::vector<std::string>;
-    using pgn_book = std::vector<Opening>;
+    using epd_book = EpdBook;
+    using pgn_book = PgnBook;
+    using bin_book = BinBook;
 
     std::size_t start_ = 0;
-    std::variant<epd_book, pgn_book> book_;
+    bool chess960_     = false;
+
+    /// @brief openings fetched so far, every book counts on its own
+    uint64_t fetched_ = 0;
+
+    /// @brief maps the position in the book to an opening, only used for random order
+    std::optional<IndexPermutation> order_;
+
+    std::variant<epd_book, pgn_book, bin_book> book_;
 };
 
 }  // namespace fast_chess
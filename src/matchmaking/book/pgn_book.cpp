@@ -0,0 +1,32 @@
+#include <matchmaking/book/pgn_book.hpp>
+
+#include <algorithm>
+
+namespace fast_chess {
+
+PgnBook::PgnBook(const std::string &file) : file_(file) {
+    const auto data = file_.view();
+
+    offsets_ = OffsetIndex(data.size());
+
+    // skip everything in front of the tags of the first game
+    std::size_t offset = 0;
+    while (offset < data.size() && data[offset] != '[') {
+        offset = std::min(data.find('\n', offset), data.size() - 1) + 1;
+    }
+
+    for (; offset < data.size(); offset = PgnReader::nextGame(data, offset)) {
+        offsets_.push_back(offset);
+    }
+
+    offsets_.shrink_to_fit();
+}
+
+Opening PgnBook::operator[](std::size_t idx) const {
+    const auto data   = file_.view();
+    const auto offset = offsets_[idx];
+
+    return PgnReader::parseGame(data.substr(offset, PgnReader::nextGame(data, offset) - offset));
+}
+
+}  // namespace fast_chess
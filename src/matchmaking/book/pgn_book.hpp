@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <matchmaking/book/offset_index.hpp>
+#include <pgn/pgn_reader.hpp>
+#include <util/mapped_file.hpp>
+
+namespace fast_chess {
+
+/// @brief A PGN book which is memory mapped and parsed lazily. Loading only records where each
+/// game starts, the moves of a game are parsed when the opening is fetched.
+class PgnBook {
+   public:
+    PgnBook() = default;
+
+    /// @brief Maps the file and indexes the start of every game.
+    /// @param file
+    explicit PgnBook(const std::string &file);
+
+    [[nodiscard]] std::size_t size() const noexcept { return offsets_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return offsets_.empty(); }
+
+    /// @brief Parses the opening of the game.
+    /// @param idx
+    /// @return
+    [[nodiscard]] Opening operator[](std::size_t idx) const;
+
+   private:
+    MappedFile file_;
+    OffsetIndex offsets_;
+};
+
+}  // namespace fast_chess
@@ -64,6 +64,52 @@ std::string Elo::getElo() const noexcept {
     return ss.str();
 }
 
+std::string Elo::getNormalizedElo(const Stats &stats) noexcept {
+    const int pairs = stats.penta_WW + stats.penta_WD + stats.penta_WL + stats.penta_DD +
+                      stats.penta_LD + stats.penta_LL;
+
+    double score = 0.0, game_variance = 0.0, games = 0.0;
+
+    if (pairs > 0) {
+        const double counts[5] = {double(stats.penta_LL), double(stats.penta_LD),
+                                  double(stats.penta_WL + stats.penta_DD), double(stats.penta_WD),
+                                  double(stats.penta_WW)};
+        const double scores[5] = {0.0, 0.25, 0.5, 0.75, 1.0};
+
+        double var = 0.0;
+        for (int i = 0; i < 5; i++) score += counts[i] / pairs * scores[i];
+        for (int i = 0; i < 5; i++) var += counts[i] / pairs * std::pow(scores[i] - score, 2);
+
+        // the pair score is the mean of two games
+        game_variance = 2 * var;
+        games         = 2.0 * pairs;
+    } else {
+        games = stats.sum();
+
+        if (games > 0) {
+            const double w = stats.wins / games, d = stats.draws / games;
+            score          = w + d / 2;
+            game_variance  = w + d / 4 - std::pow(score, 2);
+        }
+    }
+
+    double nelo = 0.0, error = 0.0;
+
+    if (game_variance > 0.0) {
+        const double sigma = std::sqrt(game_variance);
+
+        nelo  = (score - 0.5) / sigma * NELO_DIVIDED_BY_NT;
+        error = phiInv(0.975) / std::sqrt(games) * NELO_DIVIDED_BY_NT;
+    }
+
+    std::stringstream ss;
+
+    ss << std::fixed << std::setprecision(2) << nelo;
+    ss << " +/- ";
+    ss << std::fixed << std::setprecision(2) << error;
+    return ss.str();
+}
+
 std::string Elo::getLos(int wins, int losses) noexcept {
     const double los = (0.5 + 0.5 * std::erf((wins - losses) / std::sqrt(2.0 * (wins + losses))));
     std::stringstream ss;
@@ -2,9 +2,14 @@
 
 #include <string>
 
+#include <types/stats.hpp>
+
 namespace fast_chess {
 class Elo {
    public:
+    /// @brief normalized elo per unit of (score - 0.5) / standard deviation of a game
+    static constexpr double NELO_DIVIDED_BY_NT = 800.0 / 2.302585092994046;
+
     Elo(int wins, int losses, int draws);
 
     [[nodiscard]] static double inverseError(double x) noexcept;
@@ -19,6 +24,12 @@ class Elo {
 
     [[nodiscard]] std::string getElo() const noexcept;
 
+    /// @brief Normalized elo with its 95% error. The game pairs are used if they were counted,
+    /// otherwise the single games.
+    /// @param stats
+    /// @return
+    [[nodiscard]] static std::string getNormalizedElo(const Stats &stats) noexcept;
+
     [[nodiscard]] static std::string getLos(int wins, int losses) noexcept;
 
     [[nodiscard]] static std::string getDrawRatio(int wins, int losses, int draws) noexcept;
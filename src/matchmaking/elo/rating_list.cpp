@@ -0,0 +1,190 @@
+#include <matchmaking/elo/rating_list.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include <matchmaking/elo/elo.hpp>
+
+namespace fast_chess {
+
+namespace {
+
+/// @brief derivative of the expected score with respect to the elo difference, per p * (1 - p)
+constexpr double SCALE = 2.302585092994046 / 400.0;
+
+}  // namespace
+
+RatingList::RatingList(std::vector<std::string> names) : names_(std::move(names)) {
+    const auto n = names_.size();
+
+    ratings_.assign(n, 0.0);
+    games_.assign(n * n, 0.0);
+    score_.assign(n * n, 0.0);
+    draws_.assign(n, 0);
+}
+
+void RatingList::add(std::size_t first, std::size_t second, const Stats &stats) {
+    const auto n = names_.size();
+
+    const double games  = stats.sum();
+    const double points = stats.wins + stats.draws / 2.0;
+
+    games_[first * n + second] += games;
+    games_[second * n + first] += games;
+    score_[first * n + second] += points;
+    score_[second * n + first] += games - points;
+
+    draws_[first] += stats.draws;
+    draws_[second] += stats.draws;
+}
+
+double RatingList::expected(std::size_t i, std::size_t j) const noexcept {
+    return 1.0 / (1.0 + std::pow(10.0, (ratings_[j] - ratings_[i]) / 400.0));
+}
+
+int RatingList::update() {
+    const auto n = names_.size();
+
+    for (int iteration = 1; iteration <= MAX_ITERATIONS; iteration++) {
+        double max_delta = 0.0;
+
+        // newton step per engine with the others fixed, converges without any step size
+        for (std::size_t i = 0; i < n; i++) {
+            double gradient = 0.0, curvature = 0.0;
+
+            for (std::size_t j = 0; j < n; j++) {
+                const double games = games_[i * n + j];
+
+                if (i == j || games == 0.0) continue;
+
+                const double p = expected(i, j);
+
+                gradient += score_[i * n + j] + PRIOR_DRAWS / 2 - (games + PRIOR_DRAWS) * p;
+                curvature += (games + PRIOR_DRAWS) * p * (1 - p);
+            }
+
+            if (curvature == 0.0) continue;
+
+            const double delta = gradient / (curvature * SCALE);
+
+            ratings_[i] += delta;
+            max_delta = std::max(max_delta, std::abs(delta));
+        }
+
+        // only the differences are defined, keep the average at zero
+        const double mean = std::accumulate(ratings_.begin(), ratings_.end(), 0.0) / n;
+        for (auto &rating : ratings_) rating -= mean;
+
+        if (max_delta < PRECISION) return iteration;
+    }
+
+    return MAX_ITERATIONS;
+}
+
+std::vector<double> RatingList::information() const {
+    const auto n = names_.size();
+
+    std::vector<double> matrix(n * n, 0.0);
+
+    for (std::size_t i = 0; i < n; i++) {
+        for (std::size_t j = 0; j < n; j++) {
+            const double games = games_[i * n + j];
+
+            if (i == j || games == 0.0) continue;
+
+            const double p      = expected(i, j);
+            const double weight = (games + PRIOR_DRAWS) * p * (1 - p) * SCALE * SCALE;
+
+            matrix[i * n + j] -= weight;
+            matrix[i * n + i] += weight;
+        }
+    }
+
+    return matrix;
+}
+
+std::vector<RatingList::Rating> RatingList::get() const {
+    const auto n = names_.size();
+
+    // the information is singular along equal shifts of all ratings, adding 1/n there makes it
+    // invertible and subtracting 1/n again from the inverse leaves the covariance of the ratings
+    auto matrix = information();
+    for (auto &value : matrix) value += 1.0 / n;
+
+    std::vector<double> inverse(n * n, 0.0);
+    for (std::size_t i = 0; i < n; i++) inverse[i * n + i] = 1.0;
+
+    bool singular = false;
+
+    // gauss jordan with partial pivoting
+    for (std::size_t col = 0; col < n && !singular; col++) {
+        std::size_t pivot = col;
+
+        for (std::size_t row = col + 1; row < n; row++) {
+            if (std::abs(matrix[row * n + col]) > std::abs(matrix[pivot * n + col])) pivot = row;
+        }
+
+        // engines which are not connected by games can not be compared
+        if (std::abs(matrix[pivot * n + col]) < 1e-12) {
+            singular = true;
+            break;
+        }
+
+        for (std::size_t k = 0; k < n; k++) {
+            std::swap(matrix[col * n + k], matrix[pivot * n + k]);
+            std::swap(inverse[col * n + k], inverse[pivot * n + k]);
+        }
+
+        const double scale = matrix[col * n + col];
+
+        for (std::size_t k = 0; k < n; k++) {
+            matrix[col * n + k] /= scale;
+            inverse[col * n + k] /= scale;
+        }
+
+        for (std::size_t row = 0; row < n; row++) {
+            const double factor = matrix[row * n + col];
+
+            if (row == col || factor == 0.0) continue;
+
+            for (std::size_t k = 0; k < n; k++) {
+                matrix[row * n + k] -= factor * matrix[col * n + k];
+                inverse[row * n + k] -= factor * inverse[col * n + k];
+            }
+        }
+    }
+
+    std::vector<Rating> ratings(n);
+
+    for (std::size_t i = 0; i < n; i++) {
+        auto &rating = ratings[i];
+
+        rating.name  = names_[i];
+        rating.elo   = ratings_[i];
+        rating.draws = draws_[i];
+
+        double games = 0.0, points = 0.0;
+
+        for (std::size_t j = 0; j < n; j++) {
+            games += games_[i * n + j];
+            points += score_[i * n + j];
+        }
+
+        rating.games = static_cast<int>(games);
+        rating.score = games > 0.0 ? points / games : 0.0;
+
+        const double variance = inverse[i * n + i] - 1.0 / n;
+
+        rating.error = singular || variance < 0.0 ? std::numeric_limits<double>::infinity()
+                                                  : Elo::phiInv(0.975) * std::sqrt(variance);
+    }
+
+    std::sort(ratings.begin(), ratings.end(),
+              [](const Rating &a, const Rating &b) { return a.elo > b.elo; });
+
+    return ratings;
+}
+
+}  // namespace fast_chess
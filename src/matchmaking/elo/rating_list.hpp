@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <types/stats.hpp>
+
+namespace fast_chess {
+
+/// @brief One rating list for all engines of a tournament, the maximum likelihood fit of the
+/// logistic elo model to all games played, like Ordo or BayesElo.
+///
+/// Only the results per pair of engines are stored, so adding a game and refreshing the ratings
+/// does not get slower with the number of games. The ratings of the previous fit are the start of
+/// the next one, after a single game a couple of iterations are enough.
+class RatingList {
+   public:
+    struct Rating {
+        std::string name;
+        double elo   = 0.0;
+        double error = 0.0;
+
+        int games    = 0;
+        double score = 0.0;
+        int draws    = 0;
+    };
+
+    explicit RatingList(std::vector<std::string> names);
+
+    [[nodiscard]] std::size_t size() const noexcept { return names_.size(); }
+
+    /// @brief Adds the results of first against second, the ratings are refreshed by update().
+    /// @param first
+    /// @param second
+    /// @param stats from the point of view of first
+    void add(std::size_t first, std::size_t second, const Stats &stats);
+
+    /// @brief Refits the ratings, starting from the previous fit.
+    /// @return the number of iterations needed
+    int update();
+
+    /// @brief The ratings of the last fit, best first. The errors are the 95% intervals from the
+    /// curvature of the likelihood and are computed on every call.
+    /// @return
+    [[nodiscard]] std::vector<Rating> get() const;
+
+    /// @brief virtual draws added to every pair which has played, keeps the ratings of engines
+    /// which won or lost all games finite
+    static constexpr double PRIOR_DRAWS = 2.0;
+
+   private:
+    /// @brief fisher information of the ratings, a laplacian since only differences matter
+    [[nodiscard]] std::vector<double> information() const;
+
+    /// @brief expected score of i against j
+    [[nodiscard]] double expected(std::size_t i, std::size_t j) const noexcept;
+
+    std::vector<std::string> names_;
+    std::vector<double> ratings_;
+
+    /// @brief games_[i * n + j] games of i against j, score_[i * n + j] points i scored
+    std::vector<double> games_;
+    std::vector<double> score_;
+    std::vector<int> draws_;
+
+    static constexpr int MAX_ITERATIONS = 1000;
+    static constexpr double PRECISION   = 1e-4;
+};
+
+}  // namespace fast_chess
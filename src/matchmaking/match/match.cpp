@@ -20,64 +20,69 @@ using clock      = chrono::high_resolution_clock;
 
 using namespace chess;
 
-void Match::addMoveData(const Player& player, int64_t measured_time_ms, bool legal) {
+void Match::addMoveData(const Player& player, int64_t measured_time_ms, Move move, bool legal) {
     MoveData move_data =
         MoveData(player.engine.bestmove(), "0.00", measured_time_ms, 0, 0, 0, 0, legal);
 
-    if (player.engine.output().size() <= 1) {
-        data_.moves.push_back(move_data);
+    if (player.engine.infoLines() == 0) {
+        pushMove(move_data);
         return;
     }
 
-    // extract last info line
-    const auto score_type = player.engine.lastScoreType();
-    const auto info       = player.engine.lastInfo();
+    // last info line with a score, parsed by the engine before the capture policy dropped any
+    // lines
+    const auto& info      = player.engine.lastInfo();
+    const auto score_type = info.score_type;
 
-    move_data.nps      = str_utils::findElement<int>(info, "nps").value_or(0);
-    move_data.depth    = str_utils::findElement<int>(info, "depth").value_or(0);
-    move_data.seldepth = str_utils::findElement<int>(info, "seldepth").value_or(0);
-    move_data.nodes    = str_utils::findElement<uint64_t>(info, "nodes").value_or(0);
-    move_data.score    = player.engine.lastScore();
+    move_data.nps      = static_cast<int>(info.nps);
+    move_data.depth    = info.depth;
+    move_data.seldepth = info.seldepth;
+    move_data.nodes    = info.nodes;
+    move_data.score    = info.score;
 
-    // Missing elements default to 0
-    std::stringstream ss;
+    move_data.score_string = formatScore(score_type, move_data.score);
 
-    if (score_type == ScoreType::CP) {
-        ss << (move_data.score >= 0 ? '+' : '-');
-        ss << std::fixed << std::setprecision(2) << (float(std::abs(move_data.score)) / 100);
-    } else if (score_type == ScoreType::MATE) {
-        ss << (move_data.score > 0 ? "+M" : "-M") << std::to_string(std::abs(move_data.score));
-    } else {
-        ss << "ERR";
-    }
-
-    move_data.score_string = ss.str();
+    // board_ still holds the position the engine searched
+    if (legal) training_data_.add(board_, move, info, data_.moves.size());
 
     verifyPvLines(player);
 
+    pushMove(move_data);
+}
+
+void Match::pushMove(const MoveData& move_data) {
+    position_.push(move_data.move);
     data_.moves.push_back(move_data);
 }
 
 void Match::prepare() {
-    board_.set960(tournament_options_.variant == VariantType::FRC);
-    board_.setFen(opening_.fen);
+    const bool chess960 = tournament_options_.variant == VariantType::FRC;
 
-    start_position_ = board_.getFen() == chess::constants::STARTPOS ? "startpos" : board_.getFen();
+    data_ = MatchData(opening_.fen);
 
-    const auto insert_move = [&](const auto& opening_move) {
-        const auto move = uci::moveToUci(opening_move, board_.chess960());
-        board_.makeMove(opening_move);
+    if (opening_.moves.empty()) {
+        start_position_ = OpeningBook::startPosition(board_, opening_, chess960);
+        position_.reset(start_position_);
+    } else {
+        // the book has already played the opening moves, unless the opening did not come from it
+        const auto prepared = opening_.prepared && opening_.prepared->chess960 == chess960
+                                  ? opening_.prepared
+                                  : OpeningBook::prepare(opening_, chess960);
 
-        return MoveData(move, "0.00", 0, 0, 0, 0, 0);
-    };
+        board_          = prepared->board;
+        start_position_ = prepared->start;
 
-    data_ = MatchData(opening_.fen);
+        position_.reset(start_position_);
 
-    std::transform(opening_.moves.begin(), opening_.moves.end(), std::back_inserter(data_.moves),
-                   insert_move);
+        for (const auto& move : prepared->moves) {
+            pushMove(MoveData(move, "0.00", 0, 0, 0, 0, 0));
+        }
+    }
 
     draw_tracker_   = DrawTacker(tournament_options_);
     resign_tracker_ = ResignTracker(tournament_options_);
+
+    training_data_.clear();
 }
 
 void Match::start(UciEngine& engine1, UciEngine& engine2, const std::vector<int>& cpus) {
@@ -95,18 +100,23 @@ void Match::start(UciEngine& engine1, UciEngine& engine2, const std::vector<int>
     player_1.engine.refreshUci();
     player_2.engine.refreshUci();
 
+    // the kept output may miss info lines, depending on the capture policy
+    const bool all_pvs = tournament_options_.verify_pv == PvVerificationType::ALL;
+    player_1.engine.collectPvs(all_pvs);
+    player_2.engine.collectPvs(all_pvs);
+
     const auto start = clock::now();
 
     try {
         while (true) {
-            if (atomic::stop.load()) {
+            if (interrupted()) {
                 data_.termination = MatchTermination::INTERRUPT;
                 break;
             }
 
             if (!playMove(player_1, player_2)) break;
 
-            if (atomic::stop.load()) {
+            if (interrupted()) {
                 data_.termination = MatchTermination::INTERRUPT;
                 break;
             }
@@ -148,8 +158,11 @@ bool Match::playMove(Player& us, Player& opponent) {
         return false;
     }
 
-    // disconnect
-    if (!us.engine.isResponsive()) {
+    // disconnect, without pinging we rely on the process state and the hangup of the pipe
+    const auto responsive =
+        tournament_options_.ping ? us.engine.isResponsive() : us.engine.isAlive();
+
+    if (!responsive) {
         setLose(us, opponent);
 
         data_.termination = MatchTermination::DISCONNECT;
@@ -159,25 +172,32 @@ bool Match::playMove(Player& us, Player& opponent) {
     }
 
     // write new uci position
-    std::vector<std::string> uci_moves;
-    std::transform(data_.moves.begin(), data_.moves.end(), std::back_inserter(uci_moves),
-                   [](const MoveData& data) { return data.move; });
-
-    us.engine.writeEngine(Player::buildPositionInput(uci_moves, start_position_));
+    // the buffer already holds the newline, the command is not copied again
+    us.engine.writeLine(position_.line());
     // write go command
     us.engine.writeEngine(us.buildGoInput(board_.sideToMove(), opponent.getTimeControl()));
 
     // wait for bestmove
-    const auto t0 = clock::now();
-    us.engine.readEngine("bestmove", us.getTimeoutThreshold());
-    const auto t1 = clock::now();
+    const auto t0     = clock::now();
+    const auto status = us.engine.readEngine("bestmove", us.getTimeoutThreshold());
+    const auto t1     = clock::now();
 
-    if (atomic::stop) {
+    if (interrupted()) {
         data_.termination = MatchTermination::INTERRUPT;
 
         return false;
     }
 
+    // the engine closed its output while we were waiting for the bestmove
+    if (status == Process::Status::ERR) {
+        setLose(us, opponent);
+
+        data_.termination = MatchTermination::DISCONNECT;
+        data_.reason      = name + Match::DISCONNECT_MSG;
+
+        return false;
+    }
+
     // Time forfeit
     const auto elapsed_millis = chrono::duration_cast<chrono::milliseconds>(t1 - t0).count();
     if (!us.updateTime(elapsed_millis)) {
@@ -199,14 +219,14 @@ bool Match::playMove(Player& us, Player& opponent) {
         return false;
     }
 
-    draw_tracker_.update(us.engine.lastScore(), data_.moves.size() / 2, us.engine.lastScoreType());
-    resign_tracker_.update(us.engine.lastScore(), us.engine.lastScoreType());
+    draw_tracker_.update(us.engine.lastInfo(), data_.moves.size() / 2);
+    resign_tracker_.update(us.engine.lastInfo());
 
     const auto best_move = us.engine.bestmove();
     const auto move      = uci::uciToMove(board_, best_move);
     const auto legal     = isLegal(move);
 
-    addMoveData(us, elapsed_millis, legal);
+    addMoveData(us, elapsed_millis, move, legal);
 
     if (!legal) {
         setLose(us, opponent);
@@ -231,54 +251,28 @@ bool Match::isLegal(Move move) const noexcept {
     return std::find(moves.begin(), moves.end(), move) != moves.end();
 }
 
-bool Match::isUciMove(const std::string& move) noexcept {
-    bool is_uci = false;
-
-    constexpr auto is_digit     = [](char c) { return c >= '0' && c <= '9'; };
-    constexpr auto is_file      = [](char c) { return c >= 'a' && c <= 'h'; };
-    constexpr auto is_promotion = [](char c) {
-        return c == 'n' || c == 'b' || c == 'r' || c == 'q';
-    };
-
-    // assert that the move is in uci format, [abcdefgh][0-9][abcdefgh][0-9][nbrq]
-    if (move.size() >= 4) {
-        is_uci = is_file(move[0]) && is_digit(move[1]) && is_file(move[2]) && is_digit(move[3]);
-    }
-
-    if (move.size() == 5) {
-        is_uci = is_uci && is_promotion(move[4]);
-    }
-
-    return is_uci;
+bool Match::interrupted() const noexcept {
+    return atomic::stop.load() || (interrupt_ && interrupt_->load());
 }
 
 void Match::verifyPvLines(const Player& us) {
-    const auto verifyPv = [&](const std::vector<std::string>& tokens, std::string_view info) {
-        auto tmp      = board_;
-        auto it_start = std::find(tokens.begin(), tokens.end(), "pv") + 1;
-        auto it_end   = std::find_if(it_start, tokens.end(),
-                                     [](const auto& token) { return !isUciMove(token); });
-
-        Movelist moves;
+    const auto verifyPv = [this](std::string_view pv) {
+        const auto illegal = pv_verifier_.verify(board_, pv);
 
-        std::for_each(it_start, it_end, [&](const auto& token) {
-            movegen::legalmoves(moves, tmp);
-
-            if (std::find(moves.begin(), moves.end(), uci::uciToMove(tmp, token)) == moves.end()) {
-                Logger::log<Logger::Level::WARN>("Warning; Illegal pv move ", token, "pv:", info);
-            }
-
-            tmp.makeMove(uci::uciToMove(tmp, token));
-        });
+        if (!illegal.empty()) {
+            Logger::log<Logger::Level::WARN>("Warning; Illegal pv move ", illegal, "pv:", pv);
+        }
     };
 
-    for (const auto& info : us.engine.output()) {
-        const auto tokens = str_utils::splitString(info, ' ');
-
-        // skip lines without pv
-        if (!str_utils::contains(tokens, "pv")) continue;
-
-        verifyPv(tokens, info);
+    switch (tournament_options_.verify_pv) {
+        case PvVerificationType::NONE:
+            return;
+        case PvVerificationType::LAST:
+            verifyPv(us.engine.lastInfo().pv);
+            return;
+        case PvVerificationType::ALL:
+            for (const auto& pv : us.engine.pvs()) verifyPv(pv);
+            return;
     }
 }
 
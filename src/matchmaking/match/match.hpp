@@ -1,8 +1,14 @@
 #pragma once
 
+#include <atomic>
+
 #include <chess.hpp>
 
 #include <cli/cli.hpp>
+#include <datagen/training_data.hpp>
+#include <matchmaking/book/opening_book.hpp>
+#include <matchmaking/match/position_buffer.hpp>
+#include <matchmaking/match/pv_verifier.hpp>
 #include <matchmaking/player.hpp>
 #include <pgn/pgn_reader.hpp>
 #include <types/match_data.hpp>
@@ -17,9 +23,9 @@ class DrawTacker {
         draw_score   = tournament_config.draw.score;
     }
 
-    void update(const int score, const int move_count, ScoreType score_type) noexcept {
-        if (move_count >= move_number_ && std::abs(score) <= draw_score &&
-            score_type == ScoreType::CP) {
+    void update(const UciInfo& info, const int move_count) noexcept {
+        if (move_count >= move_number_ && std::abs(info.score) <= draw_score &&
+            info.score_type == ScoreType::CP) {
             draw_moves++;
         } else {
             draw_moves = 0;
@@ -46,8 +52,8 @@ class ResignTracker {
         move_count_  = tournament_config.resign.move_count;
     }
 
-    void update(const int score, ScoreType score_type) noexcept {
-        if (std::abs(score) >= resign_score && score_type == ScoreType::CP) {
+    void update(const UciInfo& info) noexcept {
+        if (std::abs(info.score) >= resign_score && info.score_type == ScoreType::CP) {
             resign_moves++;
         } else {
             resign_moves = 0;
@@ -68,8 +74,13 @@ class ResignTracker {
 
 class Match {
    public:
-    Match(const options::Tournament& tournament_config, const Opening& opening)
-        : tournament_options_(tournament_config), opening_(opening) {}
+    /// @brief
+    /// @param tournament_config
+    /// @param opening
+    /// @param interrupt stops the match like a stop request, once the tournament no longer needs it
+    Match(const options::Tournament& tournament_config, const Opening& opening,
+          const std::atomic_bool* interrupt = nullptr)
+        : tournament_options_(tournament_config), opening_(opening), interrupt_(interrupt) {}
 
     /// @brief starts the match
     void start(UciEngine& engine1, UciEngine& engine2, const std::vector<int>& cpus);
@@ -77,8 +88,13 @@ class Match {
     /// @brief returns the match data, only valid after the match has finished
     [[nodiscard]] const MatchData& get() const { return data_; }
 
+    /// @brief returns the scored positions of the match, empty unless -datagen is used
+    [[nodiscard]] const TrainingData& trainingData() const { return training_data_; }
+
    private:
-    static bool isUciMove(const std::string& move) noexcept;
+    /// @brief checks the pv lines of the last output for illegal moves, depending on the
+    /// -verifypv option
+    /// @param us
     void verifyPvLines(const Player& us);
 
     /// @brief Add opening moves to played moves
@@ -91,8 +107,14 @@ class Match {
     /// @brief append the move data to the match data
     /// @param player
     /// @param measured_time_ms
+    /// @param move the parsed bestmove
     /// @param legal
-    void addMoveData(const Player& player, int64_t measured_time_ms, bool legal);
+    void addMoveData(const Player& player, int64_t measured_time_ms, chess::Move move,
+                     bool legal);
+
+    /// @brief append the move to the played moves and the uci position command
+    /// @param move_data
+    void pushMove(const MoveData& move_data);
 
     /// @brief returns false if the next move could not be played
     /// @param us
@@ -111,19 +133,30 @@ class Match {
 
     bool isLegal(chess::Move move) const noexcept;
 
+    /// @brief a stop request or the interrupt of the tournament
+    [[nodiscard]] bool interrupted() const noexcept;
+
     const options::Tournament& tournament_options_;
     const Opening& opening_;
+    const std::atomic_bool* interrupt_;
 
     MatchData data_     = {};
     chess::Board board_ = chess::Board();
 
     DrawTacker draw_tracker_      = DrawTacker(tournament_options_);
     ResignTracker resign_tracker_ = ResignTracker(tournament_options_);
+    TrainingData training_data_   = TrainingData(tournament_options_.datagen);
 
     // start position, required for the uci position command
     // is either startpos or the fen of the opening
     std::string start_position_;
 
+    // uci position command, grows by one move per ply
+    PositionBuffer position_;
+
+    // checks the pv lines on board_ with make/unmake
+    PvVerifier pv_verifier_;
+
     inline static constexpr char INSUFFICIENT_MSG[]      = "Draw by insufficient material";
     inline static constexpr char REPETITION_MSG[]        = "Draw by 3-fold repetition";
     inline static constexpr char ADJUDICATION_LOSE_MSG[] = " loses by adjudication";
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <matchmaking/player.hpp>
+
+namespace fast_chess {
+
+/// @brief The uci position command of a game. Instead of rebuilding the command from all moves
+/// before every ply, each move is appended once when it is played. The command is kept with its
+/// newline, so it can be written to the engine without copying it.
+class PositionBuffer {
+   public:
+    PositionBuffer() = default;
+
+    /// @brief Starts a new game from the given position.
+    /// @param fen either "startpos" or a fen
+    void reset(const std::string &fen) {
+        position_ = Player::buildPositionInput({}, fen);
+        position_.reserve(position_.size() + RESERVED_MOVE_BYTES);
+        position_ += '\n';
+        has_moves_ = false;
+    }
+
+    /// @brief Appends the move in uci notation.
+    /// @param move
+    void push(const std::string &move) {
+        position_.pop_back();
+
+        if (!has_moves_) {
+            position_ += " moves";
+            has_moves_ = true;
+        }
+
+        position_ += ' ';
+        position_ += move;
+        position_ += '\n';
+    }
+
+    /// @brief The complete "position ..." command.
+    /// @return
+    [[nodiscard]] std::string_view get() const noexcept {
+        return std::string_view(position_).substr(0, position_.size() - 1);
+    }
+
+    /// @brief The command followed by a newline, ready to be written to the engine.
+    /// @return
+    [[nodiscard]] const std::string &line() const noexcept { return position_; }
+
+   private:
+    /// @brief enough for a 300 ply game without reallocating
+    static constexpr std::size_t RESERVED_MOVE_BYTES = 2048;
+
+    std::string position_;
+    bool has_moves_ = false;
+};
+
+}  // namespace fast_chess
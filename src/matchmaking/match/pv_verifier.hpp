@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <chess.hpp>
+
+namespace fast_chess {
+
+/// @brief Checks that all moves of a pv are legal. The moves are made on the board which is passed
+/// in and unmade afterwards, so checking a pv neither copies the board nor allocates once the
+/// buffers have grown to the length of a typical pv.
+class PvVerifier {
+   public:
+    /// @brief Verifies the pv in the position of the board. The board is unchanged afterwards.
+    /// @param board
+    /// @param pv space separated moves in uci notation
+    /// @return the first illegal move, empty if all moves are legal
+    [[nodiscard]] std::string_view verify(chess::Board &board, std::string_view pv) {
+        played_.clear();
+
+        std::string_view illegal;
+
+        while (!pv.empty()) {
+            const auto begin = pv.find_first_not_of(' ');
+            if (begin == std::string_view::npos) break;
+
+            pv.remove_prefix(begin);
+
+            const auto token = pv.substr(0, pv.find(' '));
+            pv.remove_prefix(token.size());
+
+            uci_move_.assign(token);
+
+            const auto move = chess::uci::uciToMove(board, uci_move_);
+
+            chess::movegen::legalmoves(moves_, board);
+
+            if (std::find(moves_.begin(), moves_.end(), move) == moves_.end()) {
+                illegal = token;
+                break;
+            }
+
+            board.makeMove(move);
+            played_.push_back(move);
+        }
+
+        for (auto it = played_.rbegin(); it != played_.rend(); ++it) {
+            board.unmakeMove(*it);
+        }
+
+        return illegal;
+    }
+
+   private:
+    std::vector<chess::Move> played_;
+    chess::Movelist moves_;
+    std::string uci_move_;
+};
+
+}  // namespace fast_chess
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <iomanip>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include <cli/cli.hpp>
+#include <matchmaking/elo/rating_list.hpp>
 #include <matchmaking/sprt/sprt.hpp>
 #include <types/engine_config.hpp>
 #include <types/enums.hpp>
@@ -46,6 +50,36 @@ class IOutput {
     /// @param stats
     virtual void printSprt(const SPRT& sprt, const Stats& stats) = 0;
 
+    /// @brief Print the rating list of all engines.
+    /// @param ratings best first
+    virtual void printRatings(const std::vector<RatingList::Rating>& ratings) {
+        std::stringstream ss;
+
+        ss << "Rank " << std::left << std::setw(25) << "Name" << std::right  //
+           << std::setw(9) << "Elo"                                          //
+           << std::setw(9) << "+/-"                                          //
+           << std::setw(9) << "Games"                                        //
+           << std::setw(9) << "Score"                                        //
+           << std::setw(9) << "Draw"                                         //
+           << "\n";
+
+        for (std::size_t i = 0; i < ratings.size(); i++) {
+            const auto& rating = ratings[i];
+            const auto draws   = rating.games ? 100.0 * rating.draws / rating.games : 0.0;
+
+            ss << std::right << std::setw(4) << i + 1 << " "                         //
+               << std::left << std::setw(25) << rating.name << std::right          //
+               << std::fixed << std::setprecision(1) << std::setw(9) << rating.elo  //
+               << std::setw(9) << rating.error                                     //
+               << std::setw(9) << rating.games                                     //
+               << std::setw(8) << rating.score * 100.0 << "%"                      //
+               << std::setw(8) << draws << "%"                                     //
+               << "\n";
+        }
+
+        std::cout << ss.str() << std::flush;
+    }
+
     /// @brief Print game start.
     /// @param first
     /// @param second
@@ -52,9 +52,8 @@ class Cutechess : public IOutput {
         if (sprt.isValid()) {
             std::stringstream ss;
 
-            ss << "LLR: " << std::fixed << std::setprecision(2)
-               << sprt.getLLR(stats.wins, stats.draws, stats.losses) << " " << sprt.getBounds()
-               << " " << sprt.getElo() << "\n";
+            ss << "LLR: " << std::fixed << std::setprecision(2) << sprt.getLLR(stats) << " "
+               << sprt.getBounds() << " " << sprt.getElo() << "\n";
             std::cout << ss.str() << std::flush;
         }
     };
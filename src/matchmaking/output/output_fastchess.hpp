@@ -41,6 +41,9 @@ class Fastchess : public IOutput {
         ss << "Elo difference: "                                        //
            << elo.getElo()                                              //
            << ", "                                                      //
+           << "nElo: "                                                  //
+           << Elo::getNormalizedElo(stats)                              //
+           << ", "                                                      //
            << "LOS: "                                                   //
            << Elo::getLos(stats.wins, stats.losses)                     //
            << ", "                                                      //
@@ -55,9 +58,8 @@ class Fastchess : public IOutput {
         if (sprt.isValid()) {
             std::stringstream ss;
 
-            ss << "LLR: " << std::fixed << std::setprecision(2)
-               << sprt.getLLR(stats.wins, stats.draws, stats.losses) << " " << sprt.getBounds()
-               << " " << sprt.getElo() << "\n";
+            ss << "LLR: " << std::fixed << std::setprecision(2) << sprt.getLLR(stats) << " "
+               << sprt.getBounds() << " " << sprt.getElo() << "\n";
             std::cout << ss.str() << std::flush;
         }
     };
@@ -1,9 +1,14 @@
 #pragma once
 
-#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <types/engine_config.hpp>
 #include <types/stats.hpp>
@@ -13,91 +18,209 @@ namespace fast_chess {
 using stats_map   = std::unordered_map<std::string, std::unordered_map<std::string, Stats>>;
 using pair_config = std::pair<fast_chess::EngineConfiguration, fast_chess::EngineConfiguration>;
 
-class Result {
+/// @brief Holds the result of the first finished game of a round until the other game finishes.
+/// Both games of a round share one instance, so pairing them up needs neither a lookup nor a
+/// lock.
+class RoundResult {
    public:
-    /// @brief Updates the stats of engine1 vs engine2
-    /// @param engine1
-    /// @param engine2
-    /// @param stats
-    void updateStats(const pair_config& configs, const Stats& stats) noexcept {
-        std::lock_guard<std::mutex> lock(results_mutex_);
-        results_[configs.first.name][configs.second.name] += stats;
-    }
-
-    /// @brief Update the stats in pair batches to keep track of pentanomial stats.
-    /// @param first
-    /// @param engine1
-    /// @param engine2
-    /// @param stats
-    /// @param round_id
-    /// @return
-    [[nodiscard]] bool updatePairStats(const pair_config& configs, const std::string& first,
-                                       const Stats& stats, uint64_t round_id) noexcept {
-        std::lock_guard<std::mutex> lock(game_pair_cache_mutex_);
+    /// @brief Adds the result of one game of the round.
+    /// @param stats single game, from the point of view of the first engine of the pairing
+    /// @return the stats of both games including the penta counters, std::nullopt for the game
+    /// which finished first
+    [[nodiscard]] std::optional<Stats> add(const Stats &stats) noexcept {
+        const int previous = first_.exchange(encode(stats), std::memory_order_acq_rel);
 
-        const auto adjusted = first == configs.first.name ? stats : ~stats;
+        if (previous == 0) return std::nullopt;
 
-        const auto is_first_game = game_pair_cache_.find(round_id) == game_pair_cache_.end();
+        auto pair = decode(previous) + stats;
 
-        auto& lookup = game_pair_cache_[round_id];
+        pair.penta_WW += pair.wins == 2;
+        pair.penta_WD += pair.wins == 1 && pair.draws == 1;
+        pair.penta_WL += pair.wins == 1 && pair.losses == 1;
+        pair.penta_DD += pair.draws == 2;
+        pair.penta_LD += pair.losses == 1 && pair.draws == 1;
+        pair.penta_LL += pair.losses == 2;
 
-        if (is_first_game) {
-            lookup = adjusted;
-            return false;
-        } else {
-            lookup += adjusted;
+        return pair;
+    }
 
-            lookup.penta_WW += lookup.wins == 2;
-            lookup.penta_WD += lookup.wins == 1 && lookup.draws == 1;
-            lookup.penta_WL += lookup.wins == 1 && lookup.losses == 1;
-            lookup.penta_DD += lookup.draws == 2;
-            lookup.penta_LD += lookup.losses == 1 && lookup.draws == 1;
-            lookup.penta_LL += lookup.losses == 2;
+   private:
+    [[nodiscard]] static int encode(const Stats &stats) noexcept {
+        return stats.wins ? 1 : stats.losses ? 2 : 3;
+    }
 
-            updateStats(configs, first == configs.first.name ? lookup : ~lookup);
+    [[nodiscard]] static Stats decode(int code) noexcept {
+        return code == 1 ? Stats(1, 0, 0) : code == 2 ? Stats(0, 1, 0) : Stats(0, 0, 1);
+    }
 
-            game_pair_cache_.erase(round_id);
+    /// @brief 0 until the first game finished
+    std::atomic<int> first_ = 0;
+};
 
-            return true;
+/// @brief The results of all engines against each other. Every engine gets a small id when the
+/// results are created, the results are a dense matrix of atomic counters indexed by these ids.
+/// The engines are fixed afterwards, so updating and reading the results is lock free.
+class Result {
+   public:
+    /// @brief Registers the engines in order, the first one gets id 0.
+    /// @param names
+    explicit Result(const std::vector<std::string> &names) {
+        for (const auto &name : names) {
+            if (ids_.count(name)) continue;
+
+            ids_.emplace(name, names_.size());
+            names_.push_back(name);
         }
+
+        size_  = names_.size();
+        cells_ = std::make_unique<Cell[]>(size_ * size_);
     }
 
-    /// @brief Stats of engine1 vs engine2, adjusted with the perspective
-    /// @param engine1
-    /// @param engine2
+    Result(const Result &)            = delete;
+    Result &operator=(const Result &) = delete;
+
+    /// @brief Id of the engine, throws if the engine is unknown.
+    /// @param name
     /// @return
-    [[nodiscard]] Stats getStats(const std::string& engine1, const std::string& engine2) noexcept {
-        std::lock_guard<std::mutex> lock(results_mutex_);
+    [[nodiscard]] std::size_t id(const std::string &name) const {
+        const auto it = ids_.find(name);
+
+        if (it == ids_.end()) throw std::out_of_range("Unknown engine in the results: " + name);
+
+        return it->second;
+    }
 
-        const auto stats1 = results_[engine1][engine2];
-        const auto stats2 = results_[engine2][engine1];
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
 
+    /// @brief Adds the stats of engine first against engine second. Lock free.
+    /// @param first
+    /// @param second
+    /// @param stats from the point of view of first
+    void updateStats(std::size_t first, std::size_t second, const Stats &stats) noexcept {
+        cells_[first * size_ + second].add(stats);
+    }
+
+    /// @brief Stats of first against second, from both orders of the pairing. Lock free, the
+    /// counters of a game which is being added may be partially included.
+    /// @param first
+    /// @param second
+    /// @return
+    [[nodiscard]] Stats getStats(std::size_t first, std::size_t second) const noexcept {
         // we need to collect the results of engine1 vs engine2 and engine2 vs engine1
         // and combine them so that engine2's wins are engine1's losses and vice versa
-        return stats1 + ~stats2;
+        return cells_[first * size_ + second].get() + ~cells_[second * size_ + first].get();
     }
 
-    /// @brief
+    /// @brief Updates the stats of engine1 vs engine2
+    /// @param configs
+    /// @param stats
+    void updateStats(const pair_config &configs, const Stats &stats) {
+        updateStats(id(configs.first.name), id(configs.second.name), stats);
+    }
+
+    /// @brief Stats of engine1 vs engine2, adjusted with the perspective
+    /// @param engine1
+    /// @param engine2
     /// @return
-    [[nodiscard]] stats_map getResults() noexcept {
-        std::lock_guard<std::mutex> lock(results_mutex_);
-        return results_;
+    [[nodiscard]] Stats getStats(const std::string &engine1, const std::string &engine2) const {
+        return getStats(id(engine1), id(engine2));
     }
 
     /// @brief
+    /// @return
+    [[nodiscard]] stats_map getResults() const {
+        stats_map results;
+
+        for (std::size_t i = 0; i < size_; i++) {
+            for (std::size_t j = 0; j < size_; j++) {
+                const auto &cell = cells_[i * size_ + j];
+                if (cell.used) results[names_[i]][names_[j]] = cell.get();
+            }
+        }
+
+        return results;
+    }
+
+    /// @brief Restores saved results, engines which are not part of the results are skipped.
     /// @param results
-    void setResults(const stats_map& results) noexcept {
-        std::lock_guard<std::mutex> lock(results_mutex_);
-        results_ = results;
+    void setResults(const stats_map &results) {
+        for (const auto &[first, opponents] : results) {
+            const auto i = ids_.find(first);
+            if (i == ids_.end()) continue;
+
+            for (const auto &[second, stats] : opponents) {
+                const auto j = ids_.find(second);
+                if (j == ids_.end()) continue;
+
+                cells_[i->second * size_ + j->second].set(stats);
+            }
+        }
     }
 
    private:
-    /// @brief tracks the engine results
-    stats_map results_;
-    std::mutex results_mutex_;
+    struct Cell {
+        std::atomic<int> wins   = 0;
+        std::atomic<int> losses = 0;
+        std::atomic<int> draws  = 0;
+
+        std::atomic<int> penta_WW = 0;
+        std::atomic<int> penta_WD = 0;
+        std::atomic<int> penta_WL = 0;
+        std::atomic<int> penta_DD = 0;
+        std::atomic<int> penta_LD = 0;
+        std::atomic<int> penta_LL = 0;
+
+        /// @brief the pairing has been reported, even if all counters are 0
+        std::atomic_bool used = false;
+
+        void add(const Stats &stats) noexcept {
+            constexpr auto relaxed = std::memory_order_relaxed;
+
+            wins.fetch_add(stats.wins, relaxed);
+            losses.fetch_add(stats.losses, relaxed);
+            draws.fetch_add(stats.draws, relaxed);
+
+            penta_WW.fetch_add(stats.penta_WW, relaxed);
+            penta_WD.fetch_add(stats.penta_WD, relaxed);
+            penta_WL.fetch_add(stats.penta_WL, relaxed);
+            penta_DD.fetch_add(stats.penta_DD, relaxed);
+            penta_LD.fetch_add(stats.penta_LD, relaxed);
+            penta_LL.fetch_add(stats.penta_LL, relaxed);
+
+            used.store(true, relaxed);
+        }
+
+        void set(const Stats &stats) noexcept {
+            wins     = stats.wins;
+            losses   = stats.losses;
+            draws    = stats.draws;
+            penta_WW = stats.penta_WW;
+            penta_WD = stats.penta_WD;
+            penta_WL = stats.penta_WL;
+            penta_DD = stats.penta_DD;
+            penta_LD = stats.penta_LD;
+            penta_LL = stats.penta_LL;
+            used     = true;
+        }
+
+        [[nodiscard]] Stats get() const noexcept {
+            Stats stats(wins, losses, draws);
+            stats.penta_WW = penta_WW;
+            stats.penta_WD = penta_WD;
+            stats.penta_WL = penta_WL;
+            stats.penta_DD = penta_DD;
+            stats.penta_LD = penta_LD;
+            stats.penta_LL = penta_LL;
+            return stats;
+        }
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t size_ = 0;
 
-    std::unordered_map<uint64_t, Stats> game_pair_cache_;
-    std::mutex game_pair_cache_mutex_;
+    /// @brief only needed to translate names, never changed after construction
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, std::size_t> ids_;
 };
 
 }  // namespace fast_chess
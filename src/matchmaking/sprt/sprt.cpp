@@ -4,12 +4,16 @@
 #include <iomanip>
 #include <sstream>
 
+#include <matchmaking/elo/elo.hpp>
 #include <util/logger/logger.hpp>
 
 namespace fast_chess {
 
-SPRT::SPRT(double alpha, double beta, double elo0, double elo1) {
-    valid_ = alpha != 0.0 && beta != 0.0 && elo0 < elo1;
+SPRT::SPRT(double alpha, double beta, double elo0, double elo1, SprtModel model,
+           EloType elo_type) {
+    valid_    = alpha != 0.0 && beta != 0.0 && elo0 < elo1;
+    model_    = model;
+    elo_type_ = elo_type;
     if (isValid()) {
         lower_ = std::log(beta / (1 - alpha));
         upper_ = std::log((1 - beta) / alpha);
@@ -35,8 +39,53 @@ double SPRT::getLLR(int win, int draw, int loss) const noexcept {
     const double a     = W + D / 2;
     const double b     = W + D / 4;
     const double var   = b - std::pow(a, 2);
-    const double var_s = var / games;
-    return (s1_ - s0_) * (2 * a - s0_ - s1_) / var_s / 2.0;
+    return llr(a, var, games, var);
+}
+
+double SPRT::getLLR(int ll, int ld, int dd, int wd, int ww) const noexcept {
+    const double pairs = ll + ld + dd + wd + ww;
+
+    if (pairs == 0 || !valid_) return 0.0;
+
+    // score of the pair, averaged over both games
+    const double counts[5] = {double(ll), double(ld), double(dd), double(wd), double(ww)};
+    const double scores[5] = {0.0, 0.25, 0.5, 0.75, 1.0};
+
+    double a = 0.0;
+    for (int i = 0; i < 5; i++) a += counts[i] / pairs * scores[i];
+
+    double var = 0.0;
+    for (int i = 0; i < 5; i++) var += counts[i] / pairs * std::pow(scores[i] - a, 2);
+
+    // a single kind of outcome says nothing about the variance yet
+    if (var <= 0.0) return 0.0;
+
+    // the pair score is the mean of two games
+    return llr(a, var, pairs, 2 * var);
+}
+
+double SPRT::getLLR(const Stats &stats) const noexcept {
+    if (model_ == SprtModel::PENTANOMIAL) {
+        return getLLR(stats.penta_LL, stats.penta_LD, stats.penta_WL + stats.penta_DD,
+                      stats.penta_WD, stats.penta_WW);
+    }
+
+    return getLLR(stats.wins, stats.draws, stats.losses);
+}
+
+double SPRT::llr(double score, double variance, double samples,
+                 double game_variance) const noexcept {
+    double s0 = s0_, s1 = s1_;
+
+    if (elo_type_ == EloType::NORMALIZED) {
+        const double sigma = std::sqrt(game_variance);
+
+        s0 = 0.5 + elo0_ / Elo::NELO_DIVIDED_BY_NT * sigma;
+        s1 = 0.5 + elo1_ / Elo::NELO_DIVIDED_BY_NT * sigma;
+    }
+
+    const double var_s = variance / samples;
+    return (s1 - s0) * (2 * score - s0 - s1) / var_s / 2.0;
 }
 
 SPRTResult SPRT::getResult(double llr) const noexcept {
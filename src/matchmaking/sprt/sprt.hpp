@@ -2,6 +2,9 @@
 
 #include <string>
 
+#include <types/enums.hpp>
+#include <types/stats.hpp>
+
 namespace fast_chess {
 
 enum SPRTResult { SPRT_H0, SPRT_H1, SPRT_CONTINUE };
@@ -10,18 +13,44 @@ class SPRT {
    public:
     SPRT() = default;
 
-    SPRT(double alpha, double beta, double elo0, double elo1);
+    SPRT(double alpha, double beta, double elo0, double elo1,
+         SprtModel model = SprtModel::TRINOMIAL, EloType elo_type = EloType::LOGISTIC);
 
     [[nodiscard]] bool isValid() const noexcept;
 
     [[nodiscard]] static double getLL(double elo) noexcept;
     [[nodiscard]] double getLLR(int win, int draw, int loss) const noexcept;
 
+    /// @brief Generalized SPRT on the outcomes of game pairs. Paired games share the opening, so
+    /// this accounts for their correlation which the trinomial model treats as extra variance.
+    /// @param ll pairs with two losses
+    /// @param ld pairs with a loss and a draw
+    /// @param dd pairs with two draws or a win and a loss
+    /// @param wd pairs with a win and a draw
+    /// @param ww pairs with two wins
+    /// @return
+    [[nodiscard]] double getLLR(int ll, int ld, int dd, int wd, int ww) const noexcept;
+
+    /// @brief LLR of the stats with the model of the test.
+    /// @param stats
+    /// @return
+    [[nodiscard]] double getLLR(const Stats &stats) const noexcept;
+
     [[nodiscard]] SPRTResult getResult(double llr) const noexcept;
     [[nodiscard]] std::string getBounds() const noexcept;
     [[nodiscard]] std::string getElo() const noexcept;
 
    private:
+    /// @brief Normal approximation of the LLR. Normalized elo bounds are converted to score
+    /// bounds with the measured standard deviation, so they depend on the data.
+    /// @param score mean score of the samples
+    /// @param variance of a single sample
+    /// @param samples number of games or game pairs
+    /// @param game_variance variance of a single game
+    /// @return
+    [[nodiscard]] double llr(double score, double variance, double samples,
+                             double game_variance) const noexcept;
+
     double lower_ = 0.0;
     double upper_ = 0.0;
     double s0_    = 0.0;
@@ -30,6 +59,9 @@ class SPRT {
     double elo0_ = 0.0;
     double elo1_ = 0.0;
 
+    SprtModel model_  = SprtModel::TRINOMIAL;
+    EloType elo_type_ = EloType::LOGISTIC;
+
     bool valid_ = false;
 };
 
@@ -1,6 +1,17 @@
 #include <matchmaking/tournament/base/tournament.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
 #include <affinity/affinity_manager.hpp>
+#include <archive/game_archive.hpp>
 #include <engines/uci_engine.hpp>
 #include <matchmaking/book/opening_book.hpp>
 #include <matchmaking/match/match.hpp>
@@ -16,23 +27,97 @@
 
 namespace fast_chess {
 
+namespace {
+
+/// @brief The ids of the results are the indices of the engines.
+[[nodiscard]] std::vector<std::string> engineNames(
+    const std::vector<EngineConfiguration> &engine_configs) {
+    std::vector<std::string> names;
+
+    for (const auto &engine_config : engine_configs) names.push_back(engine_config.name);
+
+    return names;
+}
+
+/// @brief Opens the file for appending. Tests which are played together and name the same file
+/// share one writer, so their games never end up interleaved within each other.
+/// @param option the file was given to, a file which can not be opened is reported with it
+/// @param file
+/// @param policy of the first test which opens the file
+/// @param binary whether the file is opened in binary or in text mode
+/// @param prepare runs before the file is opened, but not for the tests which share it
+/// @return
+[[nodiscard]] std::shared_ptr<FileWriter> openShared(const std::string &option,
+                                                     const std::string &file,
+                                                     const FlushPolicy &policy, bool binary,
+                                                     const std::function<void()> &prepare = {}) {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<FileWriter>> writers;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto &writer = writers[std::filesystem::absolute(file).lexically_normal().string()];
+
+    if (auto shared = writer.lock()) return shared;
+
+    try {
+        if (prepare) prepare();
+
+        auto shared = std::make_shared<FileWriter>(file, policy, binary);
+        writer      = shared;
+
+        return shared;
+    } catch (const std::exception &e) {
+        throw std::runtime_error(std::string(e.what()) + ", given to -" + option);
+    }
+}
+
+/// @brief Opens the archive for appending, an existing archive is continued after its last
+/// complete record. The archive gets its header only once, even if several tests share it.
+[[nodiscard]] std::shared_ptr<FileWriter> openArchive(const std::string &file) {
+    return openShared("archive", file, {}, true, [&file] { GameArchive::prepareAppend(file); });
+}
+
+}  // namespace
+
 BaseTournament::BaseTournament(const options::Tournament &config,
-                               const std::vector<EngineConfiguration> &engine_configs) {
+                               const std::vector<EngineConfiguration> &engine_configs)
+    : result_(engineNames(engine_configs)) {
     tournament_options_ = config;
     engine_configs_     = engine_configs;
     output_             = OutputFactory::create(config.output);
-    book_               = OpeningBook(config.opening);
+    book_               = OpeningBook(config.opening, config.seed, config.variant);
     cores_              = std::make_unique<affinity::AffinityManager>(config.affinity,
                                                          getMaxAffinity(engine_configs));
 
-    if (!config.pgn.file.empty()) file_writer_ = std::make_unique<FileWriter>(config.pgn.file);
+    if (!config.pgn.file.empty()) {
+        FlushPolicy policy;
+        policy.entries  = std::max(config.pgn.flush_games, 1);
+        policy.interval = std::chrono::milliseconds(int64_t(config.pgn.flush_time * 1000));
+        policy.fsync    = config.pgn.fsync;
+
+        file_writer_ = openShared("pgnout", config.pgn.file, policy, false);
+    }
 
-    pool_.resize(config.concurrency);
+    if (!config.archive.empty()) archive_writer_ = openArchive(config.archive);
+
+    if (!config.datagen.file.empty()) {
+        // every game arrives as one chunk, no need to write each of them right away
+        FlushPolicy policy;
+        policy.entries = 64;
+
+        datagen_writer_ = openShared("datagen", config.datagen.file, policy,
+                                     config.datagen.format == DatagenFormat::BIN);
+    }
 }
 
 void BaseTournament::start() {
     Logger::log<Logger::Level::TRACE>("Starting...");
 
+    // only a tournament which plays by itself needs workers, the scheduler brings its own. The
+    // reactor plays all games on a single worker.
+    pool_.resize(tournament_options_.reactor ? 1 : tournament_options_.concurrency);
+
     create();
 }
 
@@ -43,25 +128,38 @@ void BaseTournament::stop() {
     pool_.kill();
 }
 
-void BaseTournament::playGame(const std::pair<EngineConfiguration, EngineConfiguration> &configs,
+std::map<std::string, std::size_t> BaseTournament::peakOutputBytes() {
+    std::map<std::string, std::size_t> peaks;
+
+    engine_cache_.forEach([this, &peaks](std::size_t id, const UciEngine &engine) {
+        auto &peak = peaks[engine_configs_[id].name];
+        peak       = std::max(peak, engine.peakOutputBytes());
+    });
+
+    return peaks;
+}
+
+void BaseTournament::playGame(const std::pair<std::size_t, std::size_t> &engines,
                               start_callback start, finished_callback finish,
                               const Opening &opening, std::size_t game_id) {
-    if (atomic::stop) return;
+    if (atomic::stop || finished_) return;
 
     const auto core = ScopeGuard(cores_->consume());
 
-    auto engine_one = ScopeGuard(engine_cache_.getEntry(configs.first.name, configs.first));
-    auto engine_two = ScopeGuard(engine_cache_.getEntry(configs.second.name, configs.second));
+    auto engine_one =
+        ScopeGuard(engine_cache_.getEntry(engines.first, engine_configs_[engines.first]));
+    auto engine_two =
+        ScopeGuard(engine_cache_.getEntry(engines.second, engine_configs_[engines.second]));
 
     start();
 
-    auto match = Match(tournament_options_, opening);
+    auto match = Match(tournament_options_, opening, &finished_);
 
     try {
         match.start(engine_one.get().get(), engine_two.get().get(), core.get().cpus);
 
         while (match.get().needs_restart) {
-            if (atomic::stop) return;
+            if (atomic::stop || finished_) return;
             match.start(engine_one.get().get(), engine_two.get().get(), core.get().cpus);
         }
 
@@ -71,7 +169,7 @@ void BaseTournament::playGame(const std::pair<EngineConfiguration, EngineConfigu
         return;
     }
 
-    if (atomic::stop) return;
+    if (atomic::stop || finished_) return;
 
     const auto match_data = match.get();
 
@@ -81,6 +179,15 @@ void BaseTournament::playGame(const std::pair<EngineConfiguration, EngineConfigu
         file_writer_->write(PgnBuilder(match_data, tournament_options_, game_id).get());
     }
 
+    if (match_data.termination != MatchTermination::INTERRUPT && archive_writer_) {
+        archive_writer_->write(GameArchive::encode(match_data, tournament_options_, game_id));
+    }
+
+    if (match_data.termination != MatchTermination::INTERRUPT && datagen_writer_ &&
+        match.trainingData().size() > 0) {
+        datagen_writer_->write(match.trainingData().get(match_data));
+    }
+
     finish({match_data}, match_data.reason);
 }
 
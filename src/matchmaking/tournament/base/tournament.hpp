@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <map>
+#include <string>
 #include <vector>
 
 #include <affinity/affinity_manager.hpp>
@@ -31,8 +34,17 @@ class BaseTournament {
     /// @brief forces the tournament to stop
     virtual void stop();
 
-    [[nodiscard]] stats_map getResults() noexcept { return result_.getResults(); }
-    void setResults(const stats_map &results) noexcept { result_.setResults(results); }
+    /// @brief The result is decided, for example by the SPRT. Games which are still running are
+    /// interrupted and no new ones are started.
+    /// @return
+    [[nodiscard]] bool finished() const noexcept { return finished_; }
+
+    [[nodiscard]] stats_map getResults() const { return result_.getResults(); }
+    void setResults(const stats_map &results) { result_.setResults(results); }
+
+    /// @brief The most output kept during a single move, per engine name.
+    /// @return
+    [[nodiscard]] std::map<std::string, std::size_t> peakOutputBytes();
 
     void setGameConfig(const options::Tournament &tournament_config) noexcept {
         tournament_options_ = tournament_config;
@@ -46,26 +58,32 @@ class BaseTournament {
     using finished_callback = std::function<void(const Stats &stats, const std::string &reason)>;
 
     /// @brief play one game and write it to the pgn file
-    /// @param configs
+    /// @param engines ids of the engines, the first one starts the game
     /// @param start
     /// @param finish
     /// @param opening
     /// @param game_id
-    void playGame(const std::pair<EngineConfiguration, EngineConfiguration> &configs,
-                  start_callback start, finished_callback finish, const Opening &opening,
-                  std::size_t game_id);
+    void playGame(const std::pair<std::size_t, std::size_t> &engines, start_callback start,
+                  finished_callback finish, const Opening &opening, std::size_t game_id);
 
     std::unique_ptr<IOutput> output_;
     std::unique_ptr<affinity::AffinityManager> cores_;
-    std::unique_ptr<FileWriter> file_writer_;
+    /// @brief the writers are shared with the other tests which use the same file
+    std::shared_ptr<FileWriter> file_writer_;
+    std::shared_ptr<FileWriter> archive_writer_;
+    std::shared_ptr<FileWriter> datagen_writer_;
 
     OpeningBook book_;
     options::Tournament tournament_options_;
     std::vector<EngineConfiguration> engine_configs_;
 
-    CachePool<UciEngine, std::string> engine_cache_ = CachePool<UciEngine, std::string>();
-    Result result_                                  = Result();
-    ThreadPool pool_                                = ThreadPool(1);
+    /// @brief engines by their id, the index in engine_configs_
+    CachePool<UciEngine, std::size_t> engine_cache_ = CachePool<UciEngine, std::size_t>();
+    Result result_;
+    /// @brief gets its workers in start()
+    ThreadPool pool_ = ThreadPool(0);
+
+    std::atomic_bool finished_ = false;
 
    private:
     int getMaxAffinity(const std::vector<EngineConfiguration> &configs) const noexcept;
@@ -0,0 +1,55 @@
+#include <matchmaking/tournament/gauntlet/gauntlet.hpp>
+
+namespace fast_chess {
+
+Gauntlet::Gauntlet(const options::Tournament &tournament_config,
+                   const std::vector<EngineConfiguration> &engine_configs)
+    : RoundRobin(tournament_config, engine_configs) {}
+
+std::vector<std::pair<std::size_t, std::size_t>> Gauntlet::pairings() const {
+    std::vector<std::pair<std::size_t, std::size_t>> pairings;
+
+    for (std::size_t i = SEED + 1; i < engine_configs_.size(); i++) {
+        pairings.emplace_back(SEED, i);
+    }
+
+    return pairings;
+}
+
+void Gauntlet::printInterval(std::size_t first, std::size_t second) {
+    RoundRobin::printInterval(first, second);
+
+    // with a single opponent the total is the same as the pairing
+    if (engine_configs_.size() <= 2) return;
+
+    output_->printElo(total(), engine_configs_[SEED].name, "all opponents", games_.done() + 1);
+}
+
+void Gauntlet::tournamentFinished() {
+    if (engine_configs_.size() <= 2) return;
+
+    const auto stats = total();
+
+    output_->printElo(stats, engine_configs_[SEED].name, "all opponents", stats.sum());
+}
+
+void Gauntlet::updateSprtStatus(std::size_t first, std::size_t second) {
+    if (engine_configs_.size() <= 2) {
+        RoundRobin::updateSprtStatus(first, second);
+        return;
+    }
+
+    checkSprt(total(), engine_configs_[SEED].name, "all opponents");
+}
+
+Stats Gauntlet::total() const noexcept {
+    Stats stats;
+
+    for (std::size_t i = SEED + 1; i < engine_configs_.size(); i++) {
+        stats += result_.getStats(SEED, i);
+    }
+
+    return stats;
+}
+
+}  // namespace fast_chess
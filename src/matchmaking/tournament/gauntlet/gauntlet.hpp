@@ -0,0 +1,44 @@
+#pragma once
+
+#include <matchmaking/tournament/roundrobin/roundrobin.hpp>
+
+namespace fast_chess {
+
+/// @brief The first engine, the seed, plays against all other engines, which do not play each
+/// other. The opponents take turns, so every pairing progresses at the same rate.
+class Gauntlet : public RoundRobin {
+   public:
+    explicit Gauntlet(const options::Tournament &tournament_config,
+                      const std::vector<EngineConfiguration> &engine_configs);
+
+   protected:
+    /// @brief the seed against every opponent
+    /// @return
+    [[nodiscard]] std::vector<std::pair<std::size_t, std::size_t>> pairings() const override;
+
+    [[nodiscard]] bool interleaved() const noexcept override { return true; }
+
+    /// @brief prints the stats of the pairing followed by the stats of the seed against all
+    /// opponents
+    /// @param first engine id
+    /// @param second engine id
+    void printInterval(std::size_t first, std::size_t second) override;
+
+    /// @brief prints the stats of the seed against all opponents
+    void tournamentFinished() override;
+
+    /// @brief the SPRT tests the seed against all opponents, a single opponent which is decided
+    /// does not end the gauntlet
+    /// @param first engine id
+    /// @param second engine id
+    void updateSprtStatus(std::size_t first, std::size_t second) override;
+
+   private:
+    /// @brief stats of the seed against all opponents combined
+    /// @return
+    [[nodiscard]] Stats total() const noexcept;
+
+    static constexpr std::size_t SEED = 0;
+};
+
+}  // namespace fast_chess
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <matchmaking/book/opening_book.hpp>
+#include <matchmaking/result.hpp>
+#include <pgn/pgn_reader.hpp>
+
+namespace fast_chess {
+
+/// @brief Hands out the games of a tournament one at a time. Workers pull the next game when they
+/// are free, so only the games which are currently played exist in memory, no matter how many
+/// rounds the tournament has.
+class MatchGenerator {
+   public:
+    struct Game {
+        /// @brief indices of the engines of the pairing, first plays white in even games
+        std::size_t first  = 0;
+        std::size_t second = 0;
+
+        /// @brief the engines swapped colors for this game
+        bool swapped = false;
+
+        Opening opening;
+
+        /// @brief shared by all games of the round, pairs up their results
+        std::shared_ptr<RoundResult> round_result;
+
+        std::size_t round_id = 0;
+        std::size_t game_id  = 0;
+    };
+
+    /// @brief
+    /// @param book both games of a round share the same opening
+    /// @param pairings engine indices, each pairing plays all its rounds before the next one
+    /// @param rounds
+    /// @param games games per round, the players swap colors after each game
+    /// @param interleave every pairing plays a round before the next round starts, all pairings
+    /// of a round share the same opening
+    MatchGenerator(OpeningBook &book, std::vector<std::pair<std::size_t, std::size_t>> pairings,
+                   int rounds, int games, bool interleave = false)
+        : book_(book),
+          pairings_(std::move(pairings)),
+          rounds_(rounds),
+          games_(games),
+          interleave_(interleave) {}
+
+    /// @brief Returns the next game, std::nullopt once all games have been handed out. Thread
+    /// safe.
+    /// @return
+    [[nodiscard]] std::optional<Game> next() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (pairing_ >= pairings_.size() || rounds_ <= 0 || games_ <= 0) return std::nullopt;
+
+        // interleaved pairings are done once the last round has been played
+        if (round_ >= std::size_t(rounds_)) return std::nullopt;
+
+        // a new round starts with a new opening
+        if (game_ == 0 && (!interleave_ || pairing_ == 0)) book_.fetch(opening_);
+
+        if (game_ == 0) round_result_ = std::make_shared<RoundResult>();
+
+        Game game;
+        game.first        = pairings_[pairing_].first;
+        game.second       = pairings_[pairing_].second;
+        game.swapped      = game_ % 2 == 1;
+        game.opening      = opening_;
+        game.round_result = round_result_;
+        game.round_id     = interleave_ ? round_ * pairings_.size() + pairing_ : round_;
+        game.game_id      = game.round_id * games_ + (game_ + 1);
+
+        // advance to the next game
+        if (++game_ == games_) {
+            game_ = 0;
+
+            if (interleave_) {
+                if (++pairing_ == pairings_.size()) {
+                    pairing_ = 0;
+                    round_++;
+                }
+            } else if (++round_ == std::size_t(rounds_)) {
+                round_ = 0;
+                pairing_++;
+            }
+        }
+
+        return game;
+    }
+
+   private:
+    OpeningBook &book_;
+
+    std::vector<std::pair<std::size_t, std::size_t>> pairings_;
+    int rounds_;
+    int games_;
+    bool interleave_;
+
+    std::mutex mutex_;
+
+    // position of the next game
+    std::size_t pairing_ = 0;
+    std::size_t round_   = 0;
+    int game_            = 0;
+
+    // opening and results of the current round
+    Opening opening_;
+    std::shared_ptr<RoundResult> round_result_;
+};
+
+}  // namespace fast_chess
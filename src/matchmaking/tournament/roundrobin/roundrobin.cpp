@@ -1,9 +1,12 @@
 #include <matchmaking/tournament/roundrobin/roundrobin.hpp>
 
+#include <algorithm>
+
 #include <chess.hpp>
 
 #include <matchmaking/output/output_factory.hpp>
 #include <pgn/pgn_builder.hpp>
+#include <process/epoll_reactor.hpp>
 #include <util/logger/logger.hpp>
 #include <util/rand.hpp>
 #include <util/scope_guard.hpp>
@@ -13,123 +16,227 @@ namespace fast_chess {
 RoundRobin::RoundRobin(const options::Tournament& tournament_config,
                        const std::vector<EngineConfiguration>& engine_configs)
     : BaseTournament(tournament_config, engine_configs) {
+    auto model = tournament_options_.sprt.model;
+
+    // the pair outcomes are only counted for the penta report
+    if (model == SprtModel::PENTANOMIAL && !tournament_options_.report_penta) {
+        Logger::log<Logger::Level::WARN>(
+            "Warning; The pentanomial SPRT needs -report penta=true, using the trinomial model.");
+        model = SprtModel::TRINOMIAL;
+    }
+
     // Initialize the SPRT test
     sprt_ = SPRT(tournament_options_.sprt.alpha, tournament_options_.sprt.beta,
-                 tournament_options_.sprt.elo0, tournament_options_.sprt.elo1);
+                 tournament_options_.sprt.elo0, tournament_options_.sprt.elo1, model,
+                 tournament_options_.sprt.elo_type);
+
+    if (engine_configs_.size() > 2) {
+        std::vector<std::string> names;
+        for (const auto& config : engine_configs_) names.push_back(config.name);
+
+        ratings_ = std::make_unique<RatingList>(std::move(names));
+    }
 }
 
 void RoundRobin::start() {
     BaseTournament::start();
 
-    // Wait for games to finish
-    while (match_count_ < total_ && !atomic::stop) {
+    wait();
+}
+
+void RoundRobin::wait() {
+    // Wait for games to finish, the finish callback of every game wakes us up
+    games_.wait(
+        WAKEUP_INTERVAL, [this] { return atomic::stop.load() || finished_.load(); }, [] {});
+
+    if (ratings_) {
+        std::lock_guard<std::mutex> lock(ratings_mutex_);
+        output_->printRatings(ratings_->get());
     }
+
+    tournamentFinished();
 }
 
 void RoundRobin::create() {
-    total_ = (engine_configs_.size() * (engine_configs_.size() - 1) / 2) *
-             tournament_options_.rounds * tournament_options_.games;
-
-    const auto create_match = [this](std::size_t i, std::size_t j, std::size_t round_id) {
-        constexpr auto normalize_stm_configs = [](const pair_config& configs,
-                                                  const chess::Color stm) {
-            // swap players if the opening is for black, to ensure that
-            // reporting the result is always white vs black
-            if (stm == chess::Color::BLACK) {
-                return std::pair{configs.second, configs.first};
-            }
+    prepare();
 
-            return configs;
-        };
+#ifdef __linux__
+    if (tournament_options_.reactor) {
+        pool_.enqueue([this] {
+            EpollReactor reactor;
 
-        constexpr auto normalize_stats = [](const Stats& stats, const chess::Color stm) {
-            // swap stats if the opening is for black, to ensure that
-            // reporting the result is always white vs black
-            if (stm == chess::Color::BLACK) {
-                return ~stats;
+            for (int i = 0; i < tournament_options_.concurrency; i++) {
+                reactor.spawn([this] { playNext(); });
             }
 
-            return stats;
-        };
+            reactor.run();
+        });
 
-        // both players get the same opening
-        const auto opening = book_.fetch();
-        const auto stm     = opening.stm;
-        const auto first   = engine_configs_[i];
-        const auto second  = engine_configs_[j];
-        auto configs       = std::pair{engine_configs_[i], engine_configs_[j]};
+        return;
+    }
+#endif
 
-        for (int g = 0; g < tournament_options_.games; g++) {
-            const std::size_t game_id = round_id * tournament_options_.games + (g + 1);
+    // instead of enqueueing every game, each worker pulls the next game once it is free
+    for (int i = 0; i < tournament_options_.concurrency; i++) {
+        pool_.enqueue(&RoundRobin::playNext, this);
+    }
+}
 
-            // callback functions, do not capture by reference
-            const auto start = [this, configs, game_id, stm, normalize_stm_configs]() {
-                output_->startGame(normalize_stm_configs(configs, stm), game_id, total_);
-            };
+void RoundRobin::playNext() {
+#ifdef __linux__
+    // a fiber would block the other fibers of its thread while it waits for a game
+    if (auto *reactor = EpollReactor::current()) {
+        for (auto turn = playNextGame(false); turn != Turn::DONE; turn = playNextGame(false)) {
+            if (turn == Turn::BUSY) reactor->sleep(EpollReactor::WAKEUP_INTERVAL);
+        }
 
-            // callback functions, do not capture by reference
-            const auto finish = [this, configs, first, second, game_id, round_id, stm,
-                                 normalize_stm_configs,
-                                 normalize_stats](const Stats& stats, const std::string& reason) {
-                const auto normalized_configs = normalize_stm_configs(configs, stm);
-                const auto normalized_stats   = normalize_stats(stats, stm);
+        return;
+    }
+#endif
+
+    while (playNextGame() == Turn::PLAYED) {
+    }
+}
 
-                output_->endGame(normalized_configs, normalized_stats, reason, game_id);
+void RoundRobin::prepare() {
+    auto games = pairings();
 
-                bool report = true;
+    games_.setTotal(games.size() * tournament_options_.rounds * tournament_options_.games);
 
-                if (tournament_options_.report_penta) {
-                    report = result_.updatePairStats(configs, first.name, stats, round_id);
-                } else {
-                    result_.updateStats(configs, stats);
-                }
+    generator_ = std::make_unique<MatchGenerator>(book_, std::move(games),
+                                                  tournament_options_.rounds,
+                                                  tournament_options_.games, interleaved());
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> RoundRobin::pairings() const {
+    std::vector<std::pair<std::size_t, std::size_t>> pairings;
 
-                // Only print the interval if the pair is complete or we are not tracking
-                // penta stats.
-                if (report) {
-                    const auto updated_stats = result_.getStats(first.name, second.name);
+    for (std::size_t i = 0; i < engine_configs_.size(); i++) {
+        for (std::size_t j = i + 1; j < engine_configs_.size(); j++) {
+            pairings.emplace_back(i, j);
+        }
+    }
+
+    return pairings;
+}
+
+void RoundRobin::printInterval(std::size_t first, std::size_t second) {
+    const auto stats = result_.getStats(first, second);
+
+    output_->printInterval(sprt_, stats, engine_configs_[first].name, engine_configs_[second].name,
+                           games_.done() + 1);
+}
 
-                    output_->printInterval(sprt_, updated_stats, first.name, second.name,
-                                           match_count_ + 1);
-                }
+RoundRobin::Turn RoundRobin::playNextGame(bool wait) {
+    if (atomic::stop || finished_) return Turn::DONE;
 
-                updateSprtStatus({first, second});
+    const auto game = nextGame(wait);
 
-                match_count_++;
-            };
+    if (!game.has_value()) return !wait && pending() ? Turn::BUSY : Turn::DONE;
 
-            pool_.enqueue(&RoundRobin::playGame, this, configs, start, finish, opening, round_id);
+    play(game.value());
 
-            // swap players
-            std::swap(configs.first, configs.second);
+    return Turn::PLAYED;
+}
+
+void RoundRobin::play(const MatchGenerator::Game& game) {
+    constexpr auto normalize_stats = [](const Stats& stats, const chess::Color stm) {
+        // swap stats if the opening is for black, to ensure that
+        // reporting the result is always white vs black
+        if (stm == chess::Color::BLACK) {
+            return ~stats;
         }
+
+        return stats;
     };
 
-    for (std::size_t i = 0; i < engine_configs_.size(); i++) {
-        for (std::size_t j = i + 1; j < engine_configs_.size(); j++) {
-            for (int k = 0; k < tournament_options_.rounds; k++) {
-                create_match(i, j, k);
-            }
+    const auto stm      = game.opening.stm;
+    const auto engines  = game.swapped ? std::pair{game.second, game.first}
+                                       : std::pair{game.first, game.second};
+    const auto game_id  = game.game_id;
+    const auto round_id = game.round_id;
+
+    // swap players if the opening is for black, to ensure that
+    // reporting the result is always white vs black
+    const auto white = stm == chess::Color::BLACK ? engines.second : engines.first;
+    const auto black = stm == chess::Color::BLACK ? engines.first : engines.second;
+
+    // the only copy of the configurations, the output wants them as a pair
+    const auto normalized_configs = std::pair{engine_configs_[white], engine_configs_[black]};
+
+    const auto start = [this, &normalized_configs, game_id]() {
+        output_->startGame(normalized_configs, game_id, games_.total());
+    };
+
+    const auto finish = [this, &game, &normalized_configs, game_id, stm,
+                         normalize_stats](const Stats& stats, const std::string& reason) {
+        output_->endGame(normalized_configs, normalize_stats(stats, stm), reason, game_id);
+
+        // the stats belong to the engine which started the game, which is game.second if swapped
+        const auto adjusted = game.swapped ? ~stats : stats;
+
+        bool report = true;
+
+        if (tournament_options_.report_penta) {
+            const auto pair = game.round_result->add(adjusted);
+
+            report = pair.has_value();
+            if (report) result_.updateStats(game.first, game.second, pair.value());
+        } else {
+            result_.updateStats(game.first, game.second, adjusted);
         }
-    }
+
+        // Only print the interval if the pair is complete or we are not tracking
+        // penta stats.
+        if (report) printInterval(game.first, game.second);
+
+        updateRatings(game, adjusted);
+        updateSprtStatus(game.first, game.second);
+
+        gameFinished(game, adjusted);
+
+        games_.finish();
+    };
+
+    BaseTournament::playGame(engines, start, finish, game.opening, round_id);
+}
+
+void RoundRobin::updateRatings(const MatchGenerator::Game& game, const Stats& stats) {
+    if (!ratings_) return;
+
+    std::lock_guard<std::mutex> lock(ratings_mutex_);
+
+    ratings_->add(game.first, game.second, stats);
+    ratings_->update();
+
+    const auto interval = std::max(tournament_options_.ratinginterval, 1);
+
+    if ((games_.done() + 1) % interval == 0) output_->printRatings(ratings_->get());
+}
+
+void RoundRobin::updateSprtStatus(std::size_t first, std::size_t second) {
+    checkSprt(result_.getStats(first, second), engine_configs_[first].name,
+              engine_configs_[second].name);
 }
 
-void RoundRobin::updateSprtStatus(const std::vector<EngineConfiguration>& engine_configs) {
+void RoundRobin::checkSprt(const Stats& stats, const std::string& first,
+                           const std::string& second) {
     if (!sprt_.isValid()) return;
 
-    const auto stats = result_.getStats(engine_configs[0].name, engine_configs[1].name);
-    const auto llr   = sprt_.getLLR(stats.wins, stats.draws, stats.losses);
+    const auto llr = sprt_.getLLR(stats);
 
-    if (sprt_.getResult(llr) != SPRT_CONTINUE || match_count_ == total_) {
-        atomic::stop = true;
+    if (sprt_.getResult(llr) != SPRT_CONTINUE || games_.done() == games_.total()) {
+        // only this tournament is done, other tournaments sharing the workers keep going
+        finished_ = true;
 
         Logger::log<Logger::Level::INFO>("SPRT test finished: " + sprt_.getBounds() + " " +
                                          sprt_.getElo());
 
-        output_->printElo(stats, engine_configs[0].name, engine_configs[1].name, match_count_);
+        output_->printElo(stats, first, second, games_.done());
         output_->endTournament();
 
-        stop();
+        // The workers stop pulling games of this tournament now, the pool is joined once the
+        // tournament is destroyed. Killing the pool here would join the worker we are running on.
     }
 }
 
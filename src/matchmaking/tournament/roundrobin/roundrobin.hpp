@@ -1,13 +1,21 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
 #include <affinity/affinity_manager.hpp>
+#include <matchmaking/elo/rating_list.hpp>
 #include <matchmaking/match/match.hpp>
 #include <matchmaking/result.hpp>
 #include <matchmaking/sprt/sprt.hpp>
+#include <matchmaking/tournament/roundrobin/match_generator.hpp>
 #include <pgn/pgn_reader.hpp>
 #include <types/stats.hpp>
 #include <types/tournament_options.hpp>
 #include <util/cache.hpp>
+#include <util/completion.hpp>
 #include <util/file_writer.hpp>
 #include <util/rand.hpp>
 #include <util/threadpool.hpp>
@@ -22,26 +30,109 @@ extern std::atomic_bool stop;
 
 class RoundRobin : public BaseTournament {
    public:
+    /// @brief What a call to playNextGame() did.
+    enum class Turn {
+        /// @brief a game has been played
+        PLAYED,
+        /// @brief no game can be started until a running game finishes, only without waiting
+        BUSY,
+        /// @brief all games have been handed out or the tournament is finished
+        DONE,
+    };
+
     explicit RoundRobin(const options::Tournament &tournament_config,
                         const std::vector<EngineConfiguration> &engine_configs);
 
     /// @brief starts the round robin
     void start() override;
 
+    /// @brief Sets up the games without starting any workers, for a pool of workers which plays
+    /// the games of several tournaments.
+    virtual void prepare();
+
+    /// @brief Plays the next game on the calling thread.
+    /// @param wait whether to wait until a game can be started, otherwise Turn::BUSY is returned
+    /// @return
+    Turn playNextGame(bool wait = true);
+
+    /// @brief Blocks until all games are done, the tournament is finished or a stop is requested,
+    /// then prints the final rating list.
+    void wait();
+
    protected:
     /// @brief creates the matches
     void create() override;
 
-   private:
-    /// @brief update the current running sprt. SPRT Config has to be valid.
-    /// @param engine_configs
-    void updateSprtStatus(const std::vector<EngineConfiguration> &engine_configs);
+    /// @brief the pairings of the tournament, every engine against every other one
+    /// @return
+    [[nodiscard]] virtual std::vector<std::pair<std::size_t, std::size_t>> pairings() const;
+
+    /// @brief whether each round is played by all pairings before the next round starts
+    /// @return
+    [[nodiscard]] virtual bool interleaved() const noexcept { return false; }
+
+    /// @brief prints the stats of the two engines, after each game or pair of games
+    /// @param first engine id
+    /// @param second engine id
+    virtual void printInterval(std::size_t first, std::size_t second);
+
+    /// @brief the next game to play, std::nullopt once all games have been handed out
+    /// @param wait whether to wait until a game can be started
+    /// @return std::nullopt without waiting if no game can be started right now, see pending()
+    [[nodiscard]] virtual std::optional<MatchGenerator::Game> nextGame(bool wait) {
+        (void)wait;
+        return generator_->next();
+    }
+
+    /// @brief games are left which can only be handed out once running games have finished
+    /// @return
+    [[nodiscard]] virtual bool pending() { return false; }
+
+    /// @brief called after the result of the game has been added, before it counts as done
+    /// @param game
+    /// @param stats from the point of view of the first engine of the game
+    virtual void gameFinished(const MatchGenerator::Game &, const Stats &) {}
+
+    /// @brief called by wait() once the tournament is over, after the final rating list
+    virtual void tournamentFinished() {}
+
+    /// @brief update the current running sprt after a game of the pairing finished
+    /// @param first engine id
+    /// @param second engine id
+    virtual void updateSprtStatus(std::size_t first, std::size_t second);
+
+    /// @brief Finishes the tournament once the SPRT of the stats is decided or all games are
+    /// done. Does nothing without a valid SPRT config.
+    /// @param stats
+    /// @param first name of the side the stats belong to
+    /// @param second name of the other side
+    void checkSprt(const Stats &stats, const std::string &first, const std::string &second);
+
+    /// @brief plays games until all games have been handed out
+    void playNext();
+
+    /// @brief number of games played and to be played
+    Completion games_;
 
     SPRT sprt_ = SPRT();
 
-    /// @brief number of games played
-    std::atomic<uint64_t> match_count_ = 0;
-    /// @brief number of games to be played
-    std::atomic<uint64_t> total_ = 0;
+    /// @brief how often waiting threads check for a stop request
+    static constexpr std::chrono::milliseconds WAKEUP_INTERVAL = std::chrono::milliseconds(250);
+
+   private:
+    /// @brief plays a single game of the generator and reports its result
+    /// @param game
+    void play(const MatchGenerator::Game &game);
+
+    /// @brief adds the game to the rating list, which is printed every ratinginterval games
+    /// @param game
+    /// @param stats from the point of view of the first engine of the game
+    void updateRatings(const MatchGenerator::Game &game, const Stats &stats);
+
+    /// @brief only kept with more than two engines, head to head results are enough otherwise
+    std::unique_ptr<RatingList> ratings_;
+    std::mutex ratings_mutex_;
+
+    std::unique_ptr<MatchGenerator> generator_;
 };
 }  // namespace fast_chess
@@ -0,0 +1,162 @@
+#include <matchmaking/tournament/scheduler/test_scheduler.hpp>
+
+#include <algorithm>
+
+#include <matchmaking/tournament/tournament_manager.hpp>
+#include <process/epoll_reactor.hpp>
+#include <util/logger/logger.hpp>
+#include <util/rand.hpp>
+
+namespace fast_chess {
+
+TestScheduler::TestScheduler(const std::vector<Test> &tests) {
+    if (tests.empty()) throw std::runtime_error("Error: No tests to start!");
+
+    for (const auto &test : tests) {
+        concurrency_ = std::max(concurrency_, test.options.concurrency);
+#ifdef __linux__
+        reactor_ = reactor_ || test.options.reactor;
+#endif
+
+        auto options = test.options;
+
+        // the tests share the workers and never start pools of their own. Pinning would hand
+        // out the same cores to every test.
+        options.affinity = false;
+
+        Share share;
+        share.weight = std::max(options.weight, 1);
+
+        tests_.push_back(TournamentManager::createTournament(options, test.engine_configs));
+        shares_.push_back(share);
+    }
+
+    pool_.resize(reactor_ ? 1 : concurrency_);
+
+    random::mersenne_rand.seed(tests.front().options.seed);
+}
+
+void TestScheduler::start() {
+    Logger::log<Logger::Level::INFO>("Starting", tests_.size(), "tests...");
+
+    for (auto &test : tests_) test->prepare();
+
+    if (reactor_) {
+#ifdef __linux__
+        pool_.enqueue([this] {
+            EpollReactor reactor;
+
+            for (int i = 0; i < concurrency_; i++) reactor.spawn([this] { work(); });
+
+            reactor.run();
+        });
+#endif
+    } else {
+        for (int i = 0; i < concurrency_; i++) {
+            pool_.enqueue(&TestScheduler::work, this);
+        }
+    }
+
+    for (std::size_t i = 0; i < tests_.size(); i++) {
+        tests_[i]->wait();
+
+        Logger::log<Logger::Level::INFO>("Finished test", i + 1);
+    }
+}
+
+void TestScheduler::stop() {
+    atomic::stop = true;
+    pool_.kill();
+
+    for (auto &test : tests_) test->stop();
+}
+
+std::optional<std::size_t> TestScheduler::pick(const std::vector<Share> &shares) noexcept {
+    std::optional<std::size_t> best;
+
+    for (std::size_t i = 0; i < shares.size(); i++) {
+        if (!shares[i].playing || shares[i].waiting) continue;
+
+        if (!best.has_value()) {
+            best = i;
+            continue;
+        }
+
+        const auto &share = shares[i];
+        const auto &other = shares[best.value()];
+
+        // games / weight < other.games / other.weight
+        const auto lhs = share.games * uint64_t(other.weight);
+        const auto rhs = other.games * uint64_t(share.weight);
+
+        if (lhs < rhs || (lhs == rhs && share.weight > other.weight)) best = i;
+    }
+
+    return best;
+}
+
+void TestScheduler::work() {
+    while (!atomic::stop) {
+        std::size_t idx;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            const auto picked = pick(shares_);
+
+            if (!picked.has_value()) {
+                const bool playing = std::any_of(shares_.begin(), shares_.end(),
+                                                 [](const Share &share) { return share.playing; });
+
+                if (!playing) return;
+
+                // every test which is left waits for its running games
+                idle(lock);
+
+                for (auto &share : shares_) share.waiting = false;
+
+                continue;
+            }
+
+            idx = picked.value();
+            shares_[idx].games++;
+        }
+
+        // a blocked worker would be lost for the other tests, so never wait for a game
+        const auto turn = tests_[idx]->playNextGame(false);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            auto &share = shares_[idx];
+
+            if (turn == RoundRobin::Turn::BUSY) {
+                share.games--;
+                share.waiting = true;
+                continue;
+            }
+
+            if (turn == RoundRobin::Turn::DONE) share.playing = false;
+            share.waiting = false;
+        }
+
+        cv_.notify_all();
+    }
+}
+
+void TestScheduler::idle(std::unique_lock<std::mutex> &lock) {
+#ifdef __linux__
+    // a fiber can not wait on the condition variable, it would block the other fibers
+    if (auto *reactor = EpollReactor::current()) {
+        lock.unlock();
+        reactor->sleep(EpollReactor::WAKEUP_INTERVAL);
+        lock.lock();
+
+        return;
+    }
+#endif
+
+    cv_.wait_for(lock, WAKEUP_INTERVAL);
+}
+
+}  // namespace fast_chess
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <matchmaking/tournament/roundrobin/roundrobin.hpp>
+#include <types/engine_config.hpp>
+#include <types/tournament_options.hpp>
+#include <util/threadpool.hpp>
+
+namespace fast_chess {
+
+/// @brief Plays several independent tests on one pool of workers. Every test has its own
+/// engines, book, sprt and results. A free worker picks the test which got the fewest games
+/// relative to its weight, so a test which is decided gives its workers to the others right away.
+class TestScheduler {
+   public:
+    struct Test {
+        options::Tournament options;
+        std::vector<EngineConfiguration> engine_configs;
+    };
+
+    /// @brief The games a test got so far and how many it should get.
+    struct Share {
+        int weight = 1;
+
+        /// @brief games handed out, including the running ones
+        uint64_t games = 0;
+
+        /// @brief false once all games have been handed out or the test is decided
+        bool playing = true;
+
+        /// @brief no game can be started until one of the running games finishes
+        bool waiting = false;
+    };
+
+    explicit TestScheduler(const std::vector<Test> &tests);
+
+    ~TestScheduler() {
+        Logger::log<Logger::Level::TRACE>("Destroying test scheduler...");
+        stop();
+    }
+
+    /// @brief plays all tests, returns once every test is done
+    void start();
+
+    /// @brief forces all tests to stop
+    void stop();
+
+    /// @brief The test a free worker should play next, the one with the fewest games per weight.
+    /// Ties go to the higher weight, then to the earlier test. Waiting tests are skipped.
+    /// @param shares
+    /// @return std::nullopt if no test has a game to start
+    [[nodiscard]] static std::optional<std::size_t> pick(const std::vector<Share> &shares) noexcept;
+
+   private:
+    /// @brief plays games of the picked tests until no test has games left
+    void work();
+
+    /// @brief waits until a game finished or the wakeup interval passed
+    /// @param lock of mutex_
+    void idle(std::unique_lock<std::mutex> &lock);
+
+    std::vector<std::unique_ptr<RoundRobin>> tests_;
+    std::vector<Share> shares_;
+    std::mutex mutex_;
+
+    /// @brief wakes up workers when a game finished, waiting tests may have a game again
+    std::condition_variable cv_;
+
+    int concurrency_ = 1;
+
+    /// @brief the workers are fibers of a single thread
+    bool reactor_ = false;
+
+    ThreadPool pool_ = ThreadPool(1);
+
+    /// @brief how often idle workers retry the waiting tests and check for a stop request
+    static constexpr std::chrono::milliseconds WAKEUP_INTERVAL = std::chrono::milliseconds(250);
+};
+
+}  // namespace fast_chess
@@ -0,0 +1,88 @@
+#include <matchmaking/tournament/swiss/swiss.hpp>
+
+namespace fast_chess {
+
+Swiss::Swiss(const options::Tournament &tournament_config,
+             const std::vector<EngineConfiguration> &engine_configs)
+    : RoundRobin(tournament_config, engine_configs),
+      pairing_(engine_configs.size(), tournament_config.rounds) {}
+
+void Swiss::prepare() { games_.setTotal(pairing_.maxPairings() * tournament_options_.games); }
+
+std::optional<MatchGenerator::Game> Swiss::nextGame(bool wait) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!atomic::stop && !finished_) {
+        if (!pending_.empty()) {
+            auto game = std::move(pending_.front());
+            pending_.pop_front();
+            return game;
+        }
+
+        if (const auto engines = pairing_.next()) {
+            Opening opening;
+            book_.fetch(opening);
+
+            const auto round_result = std::make_shared<RoundResult>();
+            const auto round_id     = round_id_++;
+
+            open_pairings_[round_id].remaining = tournament_options_.games;
+
+            // both games of a pairing are played from the same opening with swapped colors
+            for (int i = 0; i < tournament_options_.games; i++) {
+                MatchGenerator::Game game;
+                game.first        = engines->first;
+                game.second       = engines->second;
+                game.swapped      = i % 2 == 1;
+                game.opening      = opening;
+                game.round_result = round_result;
+                game.round_id     = round_id;
+                game.game_id      = round_id * tournament_options_.games + (i + 1);
+
+                pending_.push_back(std::move(game));
+            }
+
+            scheduled_ += tournament_options_.games;
+
+            continue;
+        }
+
+        // a worker shared with other tests rather plays one of their games
+        if (pairing_.done() || !wait) return std::nullopt;
+
+        // all free engines have to wait for a busy opponent, check for a stop request now and
+        // then
+        cv_.wait_for(lock, WAKEUP_INTERVAL);
+    }
+
+    return std::nullopt;
+}
+
+bool Swiss::pending() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !pairing_.done();
+}
+
+void Swiss::gameFinished(const MatchGenerator::Game &game, const Stats &stats) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto &pairing = open_pairings_[game.round_id];
+        pairing.stats += stats;
+
+        if (--pairing.remaining > 0) return;
+
+        pairing_.finish(game.first, game.second, pairing.stats);
+        open_pairings_.erase(game.round_id);
+
+        checkDone();
+    }
+
+    cv_.notify_all();
+}
+
+void Swiss::checkDone() {
+    if (pairing_.done()) games_.setTotal(scheduled_);
+}
+
+}  // namespace fast_chess
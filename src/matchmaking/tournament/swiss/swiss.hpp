@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include <matchmaking/tournament/roundrobin/roundrobin.hpp>
+#include <matchmaking/tournament/swiss/swiss_pairing.hpp>
+
+namespace fast_chess {
+
+/// @brief Every engine plays -rounds pairings against opponents with a similar score, so the
+/// number of games grows with engines * rounds instead of quadratically. A pairing is made as
+/// soon as two engines are free, workers only wait if no engine can be paired at all.
+class Swiss : public RoundRobin {
+   public:
+    explicit Swiss(const options::Tournament &tournament_config,
+                   const std::vector<EngineConfiguration> &engine_configs);
+
+    /// @brief sets up the pairing, the engines are paired while the games are played
+    void prepare() override;
+
+   protected:
+    /// @brief pairs the next engines, if there are none it waits until engines are free
+    /// @param wait
+    /// @return
+    [[nodiscard]] std::optional<MatchGenerator::Game> nextGame(bool wait) override;
+
+    /// @brief engines are still playing which can be paired again afterwards
+    /// @return
+    [[nodiscard]] bool pending() override;
+
+    /// @brief frees the engines once all games of their pairing are done
+    /// @param game
+    /// @param stats
+    void gameFinished(const MatchGenerator::Game &game, const Stats &stats) override;
+
+   private:
+    /// @brief a pairing which has not finished all of its games
+    struct OpenPairing {
+        Stats stats;
+        int remaining = 0;
+    };
+
+    /// @brief sets the total once no more engines can be paired, the upper bound is too high if
+    /// an engine is left without an opponent
+    void checkDone();
+
+    SwissPairing pairing_;
+
+    /// @brief games of the current pairings which have not been handed out yet
+    std::deque<MatchGenerator::Game> pending_;
+
+    /// @brief by round id
+    std::unordered_map<std::size_t, OpenPairing> open_pairings_;
+
+    std::size_t round_id_ = 0;
+    uint64_t scheduled_   = 0;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+}  // namespace fast_chess
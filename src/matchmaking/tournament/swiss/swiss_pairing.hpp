@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <types/stats.hpp>
+
+namespace fast_chess {
+
+/// @brief Pairs the engines of a swiss tournament. There is no barrier between the rounds, two
+/// engines are paired as soon as both are free, so a slow pairing never holds back the others.
+/// Engines which are behind in rounds are paired first, each against the free engine with the
+/// closest score which it has not played yet. Not thread safe.
+class SwissPairing {
+   public:
+    /// @brief
+    /// @param engines
+    /// @param rounds pairings per engine
+    SwissPairing(std::size_t engines, int rounds)
+        : players_(engines), rounds_(rounds > 0 ? rounds : 0) {
+        for (auto &player : players_) player.opponents.resize(engines, false);
+    }
+
+    /// @brief Pairs two free engines, the first one should play white in the first game.
+    /// @return std::nullopt if no engines can be paired right now
+    [[nodiscard]] std::optional<std::pair<std::size_t, std::size_t>> next() {
+        std::vector<std::size_t> free;
+
+        for (std::size_t i = 0; i < players_.size(); i++) {
+            if (available(i)) free.push_back(i);
+        }
+
+        // behind in rounds first, then the leaders
+        std::sort(free.begin(), free.end(), [this](std::size_t a, std::size_t b) {
+            return std::tuple(players_[a].rounds, -players_[a].score, a) <
+                   std::tuple(players_[b].rounds, -players_[b].score, b);
+        });
+
+        for (const auto engine : free) {
+            const auto opponent = findOpponent(engine, free);
+
+            if (!opponent.has_value()) continue;
+
+            return pair(engine, opponent.value());
+        }
+
+        return std::nullopt;
+    }
+
+    /// @brief Frees both engines of the pairing and adds the result to their score.
+    /// @param first
+    /// @param second
+    /// @param stats from the point of view of first, all games of the pairing
+    void finish(std::size_t first, std::size_t second, const Stats &stats) noexcept {
+        players_[first].score += 2 * stats.wins + stats.draws;
+        players_[second].score += 2 * stats.losses + stats.draws;
+
+        players_[first].busy  = false;
+        players_[second].busy = false;
+
+        busy_ -= 2;
+    }
+
+    /// @brief No engine is playing and no more pairings are possible.
+    /// @return
+    [[nodiscard]] bool done() const noexcept {
+        if (busy_ > 0) return false;
+
+        std::size_t waiting = 0;
+
+        for (std::size_t i = 0; i < players_.size(); i++) waiting += available(i);
+
+        return waiting < 2;
+    }
+
+    /// @brief Score in half points.
+    /// @param engine
+    /// @return
+    [[nodiscard]] int score(std::size_t engine) const noexcept { return players_[engine].score; }
+
+    /// @brief Number of pairings of the engine, including the current one.
+    /// @param engine
+    /// @return
+    [[nodiscard]] int rounds(std::size_t engine) const noexcept {
+        return players_[engine].rounds;
+    }
+
+    /// @brief Upper bound of the number of pairings, an engine can be left without an opponent
+    /// at the end.
+    /// @return
+    [[nodiscard]] std::size_t maxPairings() const noexcept {
+        return players_.size() * static_cast<std::size_t>(rounds_) / 2;
+    }
+
+   private:
+    struct Player {
+        std::vector<bool> opponents;
+
+        /// @brief half points
+        int score  = 0;
+        int rounds = 0;
+
+        /// @brief pairings with the first move minus pairings with the second move
+        int colors = 0;
+
+        bool busy = false;
+    };
+
+    [[nodiscard]] bool available(std::size_t engine) const noexcept {
+        return !players_[engine].busy && players_[engine].rounds < rounds_;
+    }
+
+    /// @brief The closest free opponent by score which the engine has not played. Rematches are
+    /// only allowed once every engine which still plays has been played, otherwise the engine
+    /// rather waits for a busy opponent.
+    [[nodiscard]] std::optional<std::size_t> findOpponent(
+        std::size_t engine, const std::vector<std::size_t> &free) const {
+        const auto &player = players_[engine];
+
+        bool rematch = true;
+
+        for (std::size_t i = 0; i < players_.size(); i++) {
+            if (i != engine && !player.opponents[i] && players_[i].rounds < rounds_) {
+                rematch = false;
+            }
+        }
+
+        std::optional<std::size_t> best;
+
+        const auto key = [&](std::size_t opponent) {
+            const auto &other = players_[opponent];
+
+            // opposite color preferences fit together best
+            const bool same_colors = (player.colors > 0) == (other.colors > 0) &&
+                                     player.colors != 0 && other.colors != 0;
+
+            return std::tuple(std::abs(player.score - other.score), same_colors,
+                              std::abs(player.rounds - other.rounds), opponent);
+        };
+
+        for (const auto opponent : free) {
+            if (opponent == engine || (!rematch && player.opponents[opponent])) continue;
+
+            if (!best.has_value() || key(opponent) < key(best.value())) best = opponent;
+        }
+
+        return best;
+    }
+
+    [[nodiscard]] std::pair<std::size_t, std::size_t> pair(std::size_t a, std::size_t b) noexcept {
+        // the engine which had the first move less often gets it
+        if (players_[b].colors < players_[a].colors) std::swap(a, b);
+
+        for (const auto &[engine, opponent] : {std::pair{a, b}, std::pair{b, a}}) {
+            auto &player = players_[engine];
+
+            player.opponents[opponent] = true;
+            player.rounds++;
+            player.busy = true;
+        }
+
+        players_[a].colors++;
+        players_[b].colors--;
+
+        busy_ += 2;
+
+        return {a, b};
+    }
+
+    std::vector<Player> players_;
+    int rounds_;
+
+    std::size_t busy_ = 0;
+};
+
+}  // namespace fast_chess
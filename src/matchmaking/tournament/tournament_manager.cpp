@@ -1,5 +1,9 @@
 #include <matchmaking/tournament/tournament_manager.hpp>
 
+#include <thread>
+
+#include <matchmaking/tournament/gauntlet/gauntlet.hpp>
+#include <matchmaking/tournament/swiss/swiss.hpp>
 #include <util/logger/logger.hpp>
 
 namespace fast_chess {
@@ -8,9 +12,7 @@ TournamentManager::TournamentManager(const options::Tournament& tournament_confi
                                      const std::vector<EngineConfiguration>& engine_configs)
     : engine_configs_(engine_configs),
       tournament_options_(tournament_config),
-      round_robin_(fixConfig(tournament_options_), engine_configs_) {
-    validateEngines();
-
+      tournament_(createTournament(tournament_options_, engine_configs_)) {
     // Set the seed for the random number generator
     random::mersenne_rand.seed(tournament_options_.seed);
 }
@@ -18,7 +20,32 @@ TournamentManager::TournamentManager(const options::Tournament& tournament_confi
 void TournamentManager::start() {
     Logger::log<Logger::Level::INFO>("Starting tournament...");
 
-    round_robin_.start();
+    tournament_->start();
+
+    if (!tournament_options_.ping) {
+        Logger::log<Logger::Level::INFO>("Skipped isready round trips:", UciEngine::skippedPings());
+    }
+
+    for (const auto& [name, bytes] : tournament_->peakOutputBytes()) {
+        Logger::log<Logger::Level::INFO>("Peak output retained by", name + ":", bytes, "bytes");
+    }
+}
+
+std::unique_ptr<RoundRobin> TournamentManager::createTournament(
+    const options::Tournament& config, const std::vector<EngineConfiguration>& engine_configs) {
+    validateEngines(engine_configs);
+
+    const auto fixed = fixConfig(config);
+
+    if (fixed.type == TournamentType::GAUNTLET) {
+        return std::make_unique<Gauntlet>(fixed, engine_configs);
+    }
+
+    if (fixed.type == TournamentType::SWISS) {
+        return std::make_unique<Swiss>(fixed, engine_configs);
+    }
+
+    return std::make_unique<RoundRobin>(fixed, engine_configs);
 }
 
 options::Tournament TournamentManager::fixConfig(options::Tournament config) {
@@ -34,13 +61,30 @@ options::Tournament TournamentManager::fixConfig(options::Tournament config) {
     // fix wrong config
     if (config.report_penta && config.output == OutputType::CUTECHESS) config.report_penta = false;
 
+#ifdef __linux__
+    // there are not enough cores to pin every fiber to one of its own
+    if (config.reactor && config.affinity &&
+        config.concurrency > int(std::thread::hardware_concurrency())) {
+        Logger::log<Logger::Level::WARN>(
+            "Warning: -concurrency exceeds the hardware threads, core pinning is disabled.");
+        config.affinity = false;
+    }
+#else
+    if (config.reactor) {
+        Logger::log<Logger::Level::WARN>(
+            "Warning: -reactor is only supported on Linux, every game gets a thread of its own.");
+        config.reactor = false;
+    }
+#endif
+
     if (config.opening.file.empty()) {
         Logger::log<Logger::Level::WARN>(
             "Warning: No opening book specified! Consider using one, otherwise all games will be "
             "played from the starting position.");
     }
 
-    if (config.opening.format != FormatType::EPD && config.opening.format != FormatType::PGN) {
+    if (config.opening.format != FormatType::EPD && config.opening.format != FormatType::PGN &&
+        config.opening.format != FormatType::BIN) {
         Logger::log<Logger::Level::WARN>(
             "Warning: Unknown opening format, " + std::to_string(int(config.opening.format)) + ".",
             "All games will be played from the starting position.");
@@ -49,16 +93,16 @@ options::Tournament TournamentManager::fixConfig(options::Tournament config) {
     return config;
 }
 
-void TournamentManager::validateEngines() const {
-    if (engine_configs_.size() < 2) {
+void TournamentManager::validateEngines(const std::vector<EngineConfiguration>& engine_configs) {
+    if (engine_configs.size() < 2) {
         throw std::runtime_error("Error: Need at least two engines to start!");
     }
 
-    for (std::size_t i = 0; i < engine_configs_.size(); i++) {
+    for (std::size_t i = 0; i < engine_configs.size(); i++) {
         for (std::size_t j = 0; j < i; j++) {
-            if (engine_configs_[i].name == engine_configs_[j].name) {
+            if (engine_configs[i].name == engine_configs[j].name) {
                 throw std::runtime_error("Error: Engine with the same name are not allowed!: " +
-                                         engine_configs_[i].name);
+                                         engine_configs[i].name);
             }
         }
     }
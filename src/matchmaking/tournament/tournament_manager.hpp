@@ -1,12 +1,14 @@
 #pragma once
 
+#include <memory>
+
 #include <matchmaking/tournament/roundrobin/roundrobin.hpp>
 #include <types/tournament_options.hpp>
 
 namespace fast_chess {
 
-/// @brief Manages the tournament, currently wraps round robin but can be extended to support
-/// different tournament types
+/// @brief Manages the tournament, wraps the round robin, the gauntlet or the swiss tournament
+/// depending on the tournament type
 class TournamentManager {
    public:
     TournamentManager(const options::Tournament &game_config,
@@ -19,15 +21,22 @@ class TournamentManager {
     }
 
     void start();
-    void stop() { round_robin_.stop(); }
+    void stop() { tournament_->stop(); }
+
+    [[nodiscard]] RoundRobin *tournament() { return tournament_.get(); }
 
-    [[nodiscard]] RoundRobin *roundRobin() { return &round_robin_; }
+    /// @brief Checks the engines, fixes the config and creates the tournament of its type.
+    /// @param config
+    /// @param engine_configs
+    /// @return
+    [[nodiscard]] static std::unique_ptr<RoundRobin> createTournament(
+        const options::Tournament &config, const std::vector<EngineConfiguration> &engine_configs);
 
    private:
     void saveJson() {
         nlohmann::ordered_json jsonfile = tournament_options_;
         jsonfile["engines"]             = engine_configs_;
-        jsonfile["stats"]               = round_robin_.getResults();
+        jsonfile["stats"]               = tournament_->getResults();
 
         Logger::log<Logger::Level::TRACE>("Saving results...");
 
@@ -37,13 +46,13 @@ class TournamentManager {
         Logger::log<Logger::Level::INFO>("Saved results.");
     }
 
-    options::Tournament fixConfig(options::Tournament config);
-    void validateEngines() const;
+    static options::Tournament fixConfig(options::Tournament config);
+    static void validateEngines(const std::vector<EngineConfiguration> &engine_configs);
 
     std::vector<EngineConfiguration> engine_configs_;
     options::Tournament tournament_options_;
 
-    RoundRobin round_robin_;
+    std::unique_ptr<RoundRobin> tournament_;
 };
 
 }  // namespace fast_chess
\ No newline at end of file
@@ -1,7 +1,11 @@
 #include <pgn/pgn_reader.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <future>
 #include <iostream>
-#include <memory>
+#include <streambuf>
+#include <thread>
 
 #include <chess.hpp>
 
@@ -53,18 +57,158 @@ class PGNVisitor : public chess::pgn::Visitor {
     chess::Board board_;
 };
 
-PgnReader::PgnReader(const std::string& pgn_file_path) { pgn_file_.open(pgn_file_path); }
+/// @brief Input stream buffer over memory which is owned by someone else.
+class ViewStreamBuf : public std::streambuf {
+   public:
+    explicit ViewStreamBuf(std::string_view view) {
+        auto *begin = const_cast<char*>(view.data());
+        setg(begin, begin, begin + view.size());
+    }
+};
+
+namespace {
+
+/// @brief Parses the games of the pgn with a visitor of its own.
+/// @param pgn
+/// @param pgns the parsed games are appended
+void parseStream(std::string_view pgn, std::vector<Opening>& pgns) {
+    ViewStreamBuf buffer(pgn);
+    std::istream stream(&buffer);
+
+    PGNVisitor vis(pgns);
+    chess::pgn::StreamParser parser(stream);
+    parser.readGames(vis);
+}
+
+/// @brief Whether the game has a line which is neither empty nor a tag.
+/// @param game
+/// @return
+bool hasMovetext(std::string_view game) noexcept {
+    for (std::size_t line = 0; line < game.size();) {
+        const auto line_end = std::min(game.find('\n', line), game.size());
+
+        if (game[line] != '[' && game[line] != '\r' && line_end != line) return true;
+
+        line = line_end + 1;
+    }
+
+    return false;
+}
+
+/// @brief Parses all games of the pgn. The stream parser would read the tags of the game after a
+/// game without moves as its movetext, so such a game is parsed on its own.
+/// @param pgn
+/// @return
+std::vector<Opening> parseChunk(std::string_view pgn) {
+    std::vector<Opening> pgns;
+
+    // the games in front of the next game without moves are parsed at once
+    std::size_t run = 0;
+
+    for (std::size_t offset = 0; offset < pgn.size();) {
+        const auto next = PgnReader::nextGame(pgn, offset);
+        const auto game = pgn.substr(offset, next - offset);
+
+        if (!hasMovetext(game)) {
+            parseStream(pgn.substr(run, offset - run), pgns);
+            parseStream(game, pgns);
+            run = next;
+        }
+
+        offset = next;
+    }
+
+    parseStream(pgn.substr(run), pgns);
+
+    return pgns;
+}
+
+}  // namespace
+
+PgnReader::PgnReader(const std::string& pgn_file_path, std::size_t threads)
+    : pgn_file_(pgn_file_path),
+      threads_(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads) {}
 
 std::vector<Opening> PgnReader::getOpenings() { return analyseFile(); }
 
 std::vector<Opening> PgnReader::analyseFile() {
-    std::vector<Opening> pgns_;
+    const auto pgn    = pgn_file_.view();
+    const auto chunks = std::clamp<std::size_t>(pgn.size() / MIN_CHUNK_BYTES, 1, threads_);
+
+    return parseGames(pgn, chunks);
+}
+
+Opening PgnReader::parseGame(std::string_view pgn) {
+    std::vector<Opening> pgns;
+    parseStream(pgn, pgns);
+
+    return pgns.empty() ? Opening() : std::move(pgns.front());
+}
+
+std::vector<Opening> PgnReader::parseGames(std::string_view pgn, std::size_t chunks) {
+    if (chunks <= 1) return parseChunk(pgn);
+
+    // split roughly evenly, each boundary is moved to the start of the following game
+    std::vector<std::size_t> bounds = {0};
+
+    for (std::size_t i = 1; i < chunks && bounds.back() < pgn.size(); i++) {
+        const auto target = std::max(pgn.size() / chunks * i, bounds.back());
+        const auto line   = std::min(pgn.find('\n', target), pgn.size() - 1) + 1;
+
+        bounds.push_back(nextGame(pgn, line));
+    }
+
+    if (bounds.back() < pgn.size()) bounds.push_back(pgn.size());
+
+    std::vector<std::future<std::vector<Opening>>> results;
+
+    for (std::size_t i = 0; i + 1 < bounds.size(); i++) {
+        results.push_back(std::async(std::launch::async, parseChunk,
+                                     pgn.substr(bounds[i], bounds[i + 1] - bounds[i])));
+    }
 
-    auto vis = std::make_unique<PGNVisitor>(pgns_);
-    chess::pgn::StreamParser parser(pgn_file_);
-    parser.readGames(*vis);
+    // merge in the original order, get() rethrows if a chunk failed
+    std::vector<Opening> pgns;
+
+    for (auto& result : results) {
+        auto chunk = result.get();
+        pgns.insert(pgns.end(), std::make_move_iterator(chunk.begin()),
+                    std::make_move_iterator(chunk.end()));
+    }
+
+    return pgns;
+}
+
+std::size_t PgnReader::nextGame(std::string_view pgn, std::size_t offset) noexcept {
+    const char* begin = pgn.data();
+    const char* end   = pgn.data() + pgn.size();
+
+    bool tags     = false;
+    bool closed   = false;
+    bool movetext = false;
+
+    for (const char* line = begin + offset; line < end;) {
+        const auto* newline  = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        const auto* line_end = newline == nullptr ? end : newline;
+        const bool empty     = line_end == line || (line_end - line == 1 && *line == '\r');
+
+        if (*line == '[') {
+            // a game without moves ends with its tags, the next game must not be merged into it
+            const bool event = std::string_view(line, line_end - line).rfind("[Event ", 0) == 0;
+
+            if (movetext || closed || (tags && event)) return line - begin;
+
+            tags = true;
+        } else if (!empty) {
+            movetext = true;
+        } else if (tags) {
+            closed = true;
+        }
+
+        line = line_end + 1;
+    }
 
-    return pgns_;
+    return pgn.size();
 }
 
 }  // namespace fast_chess
\ No newline at end of file
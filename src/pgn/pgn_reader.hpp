@@ -1,13 +1,32 @@
 #pragma once
 
-#include <fstream>
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <chess.hpp>
 
+#include <util/mapped_file.hpp>
+
 namespace fast_chess {
 
+/// @brief The position after the moves of an opening. Computed once when the opening is fetched
+/// from the book and shared by all games which start from it.
+struct PreparedOpening {
+    /// @brief the board after the opening moves, including their history
+    chess::Board board;
+
+    /// @brief either startpos or the fen of the opening, for the uci position command
+    std::string start;
+
+    /// @brief the opening moves in uci notation
+    std::vector<std::string> moves;
+
+    bool chess960 = false;
+};
+
 struct Opening {
     Opening() = default;
     Opening(const std::string& fen, const std::vector<chess::Move>& moves,
@@ -17,22 +36,53 @@ struct Opening {
     std::string fen                = chess::constants::STARTPOS;
     std::vector<chess::Move> moves = {};
     chess::Color stm               = chess::Color::WHITE;
+
+    /// @brief set by OpeningBook::fetch for openings with moves, games prepare the opening
+    /// themselves without it
+    std::shared_ptr<const PreparedOpening> prepared;
 };
 
 class PgnReader {
    public:
-    explicit PgnReader(const std::string& pgn_file_path);
+    /// @brief Maps the file, throws if it can not be opened.
+    /// @param pgn_file_path
+    /// @param threads number of threads which parse the file, 0 uses all cores
+    explicit PgnReader(const std::string& pgn_file_path, std::size_t threads = 0);
 
     /// @brief
     /// @return
     [[nodiscard]] std::vector<Opening> getOpenings();
 
+    /// @brief Parses the first game of the pgn without copying it.
+    /// @param pgn
+    /// @return the start position if the pgn contains no game
+    [[nodiscard]] static Opening parseGame(std::string_view pgn);
+
+    /// @brief Splits the pgns at game boundaries into chunks, which are parsed concurrently. The
+    /// openings are returned in the order of the games.
+    /// @param pgn
+    /// @param chunks upper bound of the number of chunks, each one is parsed on its own thread
+    /// @return
+    [[nodiscard]] static std::vector<Opening> parseGames(std::string_view pgn, std::size_t chunks);
+
+    /// @brief Finds the start of the next game after offset. A game starts with a tag line which
+    /// follows the movetext of the previous game, the empty line after its tags or, if a game
+    /// without moves lacks that line, with an Event tag.
+    /// @param pgn
+    /// @param offset the start of a line
+    /// @return pgn.size() if there is no further game
+    [[nodiscard]] static std::size_t nextGame(std::string_view pgn, std::size_t offset) noexcept;
+
    private:
     /// @brief Extracts all pgns from the file
     /// @return
     std::vector<Opening> analyseFile();
 
-    std::ifstream pgn_file_;
+    /// @brief smaller files are not worth the threads
+    static constexpr std::size_t MIN_CHUNK_BYTES = 1 << 20;
+
+    MappedFile pgn_file_;
+    std::size_t threads_;
 };
 
 }  // namespace fast_chess
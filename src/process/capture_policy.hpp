@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+namespace fast_chess {
+
+/// @brief Which info lines of the engine output are kept during a read. All other lines, like
+/// "bestmove" or "readyok", and the line the read waited for are always kept.
+struct CapturePolicy {
+    enum class Mode {
+        /// @brief keep every line
+        ALL,
+        /// @brief keep only info lines with a score or a pv
+        SCORED,
+        /// @brief keep the last `lines` info lines
+        LAST,
+    };
+
+    Mode mode = Mode::ALL;
+
+    /// @brief number of info lines kept with Mode::LAST
+    std::size_t lines = 0;
+};
+
+}  // namespace fast_chess
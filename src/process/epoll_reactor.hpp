@@ -0,0 +1,266 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include <util/logger/logger.hpp>
+
+/// @brief Runs many games on a single thread. Every game is a fiber with a stack of its own,
+/// which is suspended while the game waits for engine output. One epoll instance watches the
+/// pipes of all suspended fibers and resumes a fiber once its pipe is readable or its timeout
+/// expired. A running game therefore costs a stack, but no thread.
+///
+/// A fiber must not be suspended while it holds a lock, another fiber of the same thread would
+/// block on it forever. Fibers can not wait on condition variables either, they sleep instead.
+class EpollReactor {
+   public:
+    using clock = std::chrono::steady_clock;
+
+    /// @brief how often a fiber which waits for the other fibers checks again, it can not be
+    /// notified
+    static constexpr std::chrono::milliseconds WAKEUP_INTERVAL = std::chrono::milliseconds(10);
+
+    EpollReactor() {
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+
+        if (epoll_fd_ == -1) throw std::runtime_error("Error: Failed to create the epoll reactor");
+    }
+
+    EpollReactor(const EpollReactor &)            = delete;
+    EpollReactor &operator=(const EpollReactor &) = delete;
+
+    ~EpollReactor() { close(epoll_fd_); }
+
+    /// @brief The reactor which runs the calling fiber.
+    /// @return nullptr if the caller is not running in a fiber
+    [[nodiscard]] static EpollReactor *current() noexcept {
+        return current_ != nullptr && current_->running_ != nullptr ? current_ : nullptr;
+    }
+
+    /// @brief Adds a fiber which runs the task, the fiber starts once run() is called.
+    /// @param task
+    void spawn(std::function<void()> task) {
+        auto fiber = std::make_unique<Fiber>(std::move(task));
+
+        getcontext(&fiber->context);
+        fiber->context.uc_stack.ss_sp   = fiber->stack;
+        fiber->context.uc_stack.ss_size = STACK_SIZE;
+        // a fiber which returns from its task switches back to the scheduler
+        fiber->context.uc_link = &scheduler_;
+        makecontext(&fiber->context, &EpollReactor::entry, 0);
+
+        ready_.push_back(fiber.get());
+        fibers_.push_back(std::move(fiber));
+    }
+
+    /// @brief Runs the fibers on the calling thread until all of them returned.
+    void run() {
+        auto *const previous = current_;
+        current_             = this;
+
+        while (!fibers_.empty()) {
+            while (!ready_.empty()) {
+                running_ = ready_.front();
+                ready_.pop_front();
+
+                swapcontext(&scheduler_, &running_->context);
+
+                // the stack is only released once we are back on our own stack
+                if (running_->done) {
+                    const auto done = [this](const auto &fiber) { return fiber.get() == running_; };
+                    fibers_.erase(std::find_if(fibers_.begin(), fibers_.end(), done));
+                }
+
+                running_ = nullptr;
+            }
+
+            if (!fibers_.empty()) dispatch();
+        }
+
+        current_ = previous;
+    }
+
+    /// @brief Suspends the running fiber the same way poll() on a single descriptor would block
+    /// the thread.
+    /// @param pollfd
+    /// @param timeout_ms negative to wait without a timeout
+    /// @return 1 with the revents set, 0 on timeout, -1 if the descriptor can not be watched
+    int poll(pollfd &pollfd, int timeout_ms) {
+        auto *const fiber = running_;
+
+        epoll_event event = {};
+        event.events      = pollfd.events;
+        event.data.ptr    = fiber;
+
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, pollfd.fd, &event) == -1) return -1;
+
+        fiber->fd      = pollfd.fd;
+        fiber->revents = 0;
+
+        suspend(timeout_ms);
+
+        // the epoll events share their values with the poll events
+        pollfd.revents = static_cast<short>(fiber->revents);
+
+        return fiber->revents != 0 ? 1 : 0;
+    }
+
+    /// @brief Suspends the running fiber for the given time, the other fibers keep running.
+    /// @param duration
+    void sleep(std::chrono::milliseconds duration) {
+        running_->revents = 0;
+        suspend(std::max<int>(0, int(duration.count())));
+    }
+
+   private:
+    /// @brief large enough for a game, only the pages which are used get memory
+    static constexpr std::size_t STACK_SIZE = 1024 * 1024;
+
+    struct Fiber {
+        explicit Fiber(std::function<void()> func) : task(std::move(func)) {
+            stack = mmap(nullptr, STACK_SIZE, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+
+            if (stack == MAP_FAILED) throw std::runtime_error("Error: Failed to map a fiber stack");
+
+            // an overflow hits the guard page instead of the memory below the stack
+            mprotect(stack, std::size_t(sysconf(_SC_PAGESIZE)), PROT_NONE);
+        }
+
+        Fiber(const Fiber &)            = delete;
+        Fiber &operator=(const Fiber &) = delete;
+
+        ~Fiber() { munmap(stack, STACK_SIZE); }
+
+        std::function<void()> task;
+
+        void *stack = nullptr;
+        ucontext_t context;
+
+        /// @brief the descriptor the fiber waits for, -1 if it sleeps
+        int fd           = -1;
+        uint32_t revents = 0;
+
+        bool timed = false;
+        clock::time_point deadline;
+
+        bool done = false;
+    };
+
+    static void entry() {
+        auto *const fiber = current_->running_;
+
+        // an exception can not leave the fiber, there is no caller to catch it
+        try {
+            fiber->task();
+        } catch (const std::exception &e) {
+            fast_chess::Logger::log<fast_chess::Logger::Level::ERR>(
+                "Raised Exception in a game fiber:", e.what());
+        } catch (...) {
+            fast_chess::Logger::log<fast_chess::Logger::Level::ERR>(
+                "Raised unknown Exception in a game fiber");
+        }
+
+        fiber->done = true;
+    }
+
+    /// @brief Switches from the running fiber back to the scheduler until the fiber is resumed.
+    /// @param timeout_ms negative to wait without a timeout
+    void suspend(int timeout_ms) {
+        auto *const fiber = running_;
+
+        fiber->timed    = timeout_ms >= 0;
+        fiber->deadline = clock::now() + std::chrono::milliseconds(std::max(timeout_ms, 0));
+
+        waiting_.push_back(fiber);
+
+        swapcontext(&fiber->context, &scheduler_);
+    }
+
+    /// @brief Waits until the pipe of a fiber is readable or a timeout expires and makes those
+    /// fibers ready.
+    void dispatch() {
+        int timeout_ms = -1;
+
+        const auto now = clock::now();
+
+        for (const auto *fiber : waiting_) {
+            if (!fiber->timed) continue;
+
+            // round up, waking up early would only come back here
+            const auto remaining = std::max<int64_t>(
+                0, std::chrono::ceil<std::chrono::milliseconds>(fiber->deadline - now).count());
+
+            if (timeout_ms < 0 || remaining < timeout_ms) timeout_ms = int(remaining);
+        }
+
+        constexpr int max_events = 64;
+
+        epoll_event events[max_events];
+
+        const int ready = epoll_wait(epoll_fd_, events, max_events, timeout_ms);
+
+        if (ready == -1 && errno != EINTR) throw std::runtime_error("Error: epoll_wait() failed");
+
+        for (int i = 0; i < ready; i++) {
+            auto *const fiber = static_cast<Fiber *>(events[i].data.ptr);
+
+            fiber->revents = events[i].events;
+            resume(fiber);
+        }
+
+        const auto expired = clock::now();
+
+        for (std::size_t i = 0; i < waiting_.size();) {
+            auto *const fiber = waiting_[i];
+
+            // resume() removes the fiber, the next one moved to its place
+            if (fiber->timed && fiber->deadline <= expired) {
+                resume(fiber);
+            } else {
+                i++;
+            }
+        }
+    }
+
+    void resume(Fiber *fiber) {
+        if (fiber->fd != -1) {
+            // the pipe might have been closed already, which removed it from the epoll instance
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fiber->fd, nullptr);
+            fiber->fd = -1;
+        }
+
+        waiting_.erase(std::find(waiting_.begin(), waiting_.end(), fiber));
+        ready_.push_back(fiber);
+    }
+
+    inline static thread_local EpollReactor *current_ = nullptr;
+
+    int epoll_fd_ = -1;
+
+    ucontext_t scheduler_;
+    Fiber *running_ = nullptr;
+
+    std::vector<std::unique_ptr<Fiber>> fibers_;
+    std::deque<Fiber *> ready_;
+    std::vector<Fiber *> waiting_;
+};
+
+#endif
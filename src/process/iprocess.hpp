@@ -1,11 +1,14 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include <process/capture_policy.hpp>
+
 class IProcess {
    public:
     enum class Status { OK, ERR, TIMEOUT };
@@ -24,14 +27,27 @@ class IProcess {
 
     virtual void restart() = 0;
 
+    /// @brief Sets which info lines are kept during a read.
+    /// @param policy
+    virtual void setCapture(const fast_chess::CapturePolicy &policy) = 0;
+
+    /// @brief The largest number of output bytes which were kept during a single read.
+    /// @return
+    [[nodiscard]] virtual std::size_t peakOutputBytes() const noexcept = 0;
+
    protected:
     /// @brief Read stdout until the line matches last_word or timeout is reached
-    /// @param lines
+    /// @param lines views of the lines, valid until the next read
     /// @param last_word
     /// @param threshold 0 means no timeout
-    virtual Status readProcess(std::vector<std::string> &lines, std::string_view last_word,
+    virtual Status readProcess(std::vector<std::string_view> &lines, std::string_view last_word,
                                std::chrono::milliseconds threshold) = 0;
 
+    /// @brief Called by readProcess for every line as it is read, before the capture policy
+    /// decides whether the line is kept.
+    /// @param line only valid during the call
+    virtual void onLine(std::string_view line) { (void)line; }
+
     // Write input to the engine's stdin
     virtual void writeProcess(const std::string &input) = 0;
 };
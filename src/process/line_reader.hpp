@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <process/capture_policy.hpp>
+
+/// @brief Splits the raw output of an engine into lines.
+///
+/// Bytes are read straight into a buffer and scanned with memchr. Bytes after the last complete
+/// line stay buffered for the next read. Completed lines are copied once into an arena and handed
+/// out as views. Both buffers keep their capacity across reads, so once they have grown to the
+/// size of a typical move the reading loop no longer allocates.
+///
+/// The capture policy decides which info lines are stored, so that verbose engines can not grow
+/// the arena without bound.
+class LineReader {
+   public:
+    /// @brief Returns writable space for at least n bytes, which have to be committed afterwards.
+    /// Invalidates the view returned by next().
+    /// @param n
+    /// @return
+    [[nodiscard]] char *prepare(std::size_t n) {
+        if (tail_ + n > buffer_.size()) {
+            // move the incomplete line to the front before growing the buffer
+            if (head_ != 0) {
+                std::memmove(buffer_.data(), buffer_.data() + head_, tail_ - head_);
+                tail_ -= head_;
+                head_ = 0;
+            }
+
+            if (tail_ + n > buffer_.size()) buffer_.resize(std::max(buffer_.size() * 2, tail_ + n));
+        }
+
+        return buffer_.data() + tail_;
+    }
+
+    /// @brief Marks n bytes written to the space returned by prepare() as read.
+    /// @param n
+    void commit(std::size_t n) noexcept { tail_ += n; }
+
+    /// @brief Copies raw bytes into the buffer.
+    /// @param data
+    /// @param n
+    void append(const char *data, std::size_t n) {
+        std::memcpy(prepare(n), data, n);
+        commit(n);
+    }
+
+    /// @brief Extracts the next complete line from the buffered bytes, without the line ending.
+    /// The view is valid until the next call to prepare().
+    /// @param line
+    /// @return false if there is no complete line buffered
+    [[nodiscard]] bool next(std::string_view &line) noexcept {
+        if (head_ == tail_) return false;
+
+        const char *begin = buffer_.data() + head_;
+        const auto *end   = static_cast<const char *>(std::memchr(begin, '\n', tail_ - head_));
+
+        if (end == nullptr) return false;
+
+        line  = std::string_view(begin, end - begin);
+        head_ = end - buffer_.data() + 1;
+
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+        // nothing left, start at the front again
+        if (head_ == tail_) head_ = tail_ = 0;
+
+        return true;
+    }
+
+    /// @brief The bytes of the incomplete line which has been buffered so far.
+    /// @return
+    [[nodiscard]] std::string_view partial() const noexcept {
+        return std::string_view(buffer_.data() + head_, tail_ - head_);
+    }
+
+    /// @brief Drops all buffered bytes.
+    void discard() noexcept { head_ = tail_ = 0; }
+
+    /// @brief Copies the line into the arena, unless the capture policy drops it.
+    /// @param line
+    /// @param keep store the line regardless of the policy
+    void store(std::string_view line, bool keep = false) {
+        // lines which have to be kept are never dropped later on either
+        const bool info = !keep && line.rfind("info", 0) == 0;
+
+        if (info) {
+            if (policy_.mode == fast_chess::CapturePolicy::Mode::SCORED &&
+                line.find(" score ") == std::string_view::npos &&
+                line.find(" pv ") == std::string_view::npos) {
+                return;
+            }
+
+            if (policy_.mode == fast_chess::CapturePolicy::Mode::LAST && policy_.lines == 0) return;
+        }
+
+        spans_.push_back({arena_.size(), line.size(), info});
+        arena_.append(line);
+
+        if (info) info_lines_++;
+
+        // dropping lines moves the arena, only do it once enough of them have piled up
+        if (policy_.mode == fast_chess::CapturePolicy::Mode::LAST &&
+            info_lines_ > 2 * policy_.lines) {
+            dropInfoLines(info_lines_ - policy_.lines);
+        }
+
+        peak_bytes_ = std::max(peak_bytes_, arena_.size());
+    }
+
+    /// @brief Forgets the stored lines, the storage is kept for the next read.
+    void clear() noexcept {
+        arena_.clear();
+        spans_.clear();
+        info_lines_ = 0;
+    }
+
+    /// @brief Views of the stored lines, valid until the next store() or clear().
+    /// @param lines
+    void views(std::vector<std::string_view> &lines) {
+        if (policy_.mode == fast_chess::CapturePolicy::Mode::LAST && info_lines_ > policy_.lines) {
+            dropInfoLines(info_lines_ - policy_.lines);
+        }
+
+        lines.clear();
+
+        for (const auto &span : spans_) {
+            lines.emplace_back(arena_.data() + span.offset, span.size);
+        }
+    }
+
+    void setCapture(const fast_chess::CapturePolicy &policy) noexcept { policy_ = policy; }
+
+    /// @brief The largest number of bytes which were stored during a single read.
+    /// @return
+    [[nodiscard]] std::size_t peakBytes() const noexcept { return peak_bytes_; }
+
+   private:
+    /// @brief raw bytes, [head_, tail_) has not been split yet
+    std::vector<char> buffer_;
+    std::size_t head_ = 0;
+    std::size_t tail_ = 0;
+
+    struct Span {
+        std::size_t offset;
+        std::size_t size;
+        bool info;
+    };
+
+    /// @brief Removes the oldest info lines and moves the remaining lines to the front.
+    /// @param count
+    void dropInfoLines(std::size_t count) {
+        std::size_t size = 0;
+        auto out         = spans_.begin();
+
+        for (const auto &span : spans_) {
+            if (span.info && count > 0) {
+                count--;
+                info_lines_--;
+                continue;
+            }
+
+            std::memmove(arena_.data() + size, arena_.data() + span.offset, span.size);
+            *out++ = {size, span.size, span.info};
+            size += span.size;
+        }
+
+        spans_.erase(out, spans_.end());
+        arena_.resize(size);
+    }
+
+    /// @brief stored lines, the views are only created once the arena stopped growing
+    std::string arena_;
+    std::vector<Span> spans_;
+    std::size_t info_lines_ = 0;
+
+    fast_chess::CapturePolicy policy_;
+    std::size_t peak_bytes_ = 0;
+};
@@ -4,6 +4,7 @@
 
 #include <process/iprocess.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
@@ -25,6 +26,8 @@
 #include <wordexp.h>
 
 #include <affinity/affinity.hpp>
+#include <process/epoll_reactor.hpp>
+#include <process/line_reader.hpp>
 #include <util/logger/logger.hpp>
 #include <util/thread_vector.hpp>
 
@@ -54,12 +57,12 @@ class Process : public IProcess {
         is_initalized_ = true;
 
         // Create input pipe
-        if (pipe(in_pipe_) == -1) {
+        if (createPipe(in_pipe_) == -1) {
             throw std::runtime_error("Failed to create input pipe");
         }
 
         // Create output pipe
-        if (pipe(out_pipe_) == -1) {
+        if (createPipe(out_pipe_) == -1) {
             throw std::runtime_error("Failed to create output pipe");
         }
 
@@ -75,6 +78,12 @@ class Process : public IProcess {
 
             // Ignore signals, because the main process takes care of them
             signal(SIGINT, SIG_IGN);
+            // The main process ignores SIGPIPE, restore the default for the engine
+            signal(SIGPIPE, SIG_DFL);
+
+            // The parent's ends of the pipes are not needed
+            close(in_pipe_[0]);
+            close(out_pipe_[1]);
 
             // Redirect the child's standard input to the read end of the output pipe
             if (dup2(out_pipe_[0], 0) == -1)
@@ -120,6 +129,17 @@ class Process : public IProcess {
 
             // append the process to the list of running processes
             fast_chess::process_list.push(process_pid_);
+
+            // Close the child's ends of the pipes, otherwise we would never see the hangup when
+            // the engine exits.
+            closePipe(in_pipe_[1]);
+            closePipe(out_pipe_[0]);
+
+            // Disable blocking
+            fcntl(in_pipe_[0], F_SETFL, fcntl(in_pipe_[0], F_GETFL) | O_NONBLOCK);
+
+            // output of a previous process must not show up after a restart
+            reader_.discard();
         }
     }
 
@@ -130,6 +150,9 @@ class Process : public IProcess {
         const pid_t r = waitpid(process_pid_, &status, WNOHANG);
 
         if (r == -1) {
+            // the process has already been reaped
+            if (errno == ECHILD) return false;
+
             throw std::runtime_error("Error: waitpid() failed");
         } else {
             return r == 0;
@@ -152,10 +175,10 @@ class Process : public IProcess {
 
         if (!is_initalized_) return;
 
-        close(in_pipe_[0]);
-        close(in_pipe_[1]);
-        close(out_pipe_[0]);
-        close(out_pipe_[1]);
+        closePipe(in_pipe_[0]);
+        closePipe(in_pipe_[1]);
+        closePipe(out_pipe_[0]);
+        closePipe(out_pipe_[1]);
 
         int status;
         pid_t r = waitpid(process_pid_, &status, WNOHANG);
@@ -171,80 +194,85 @@ class Process : public IProcess {
         init(command_, args_, log_name_);
     }
 
+    void setCapture(const fast_chess::CapturePolicy &policy) override {
+        reader_.setCapture(policy);
+    }
+
+    [[nodiscard]] std::size_t peakOutputBytes() const noexcept override {
+        return reader_.peakBytes();
+    }
+
    protected:
     /// @brief Read stdout until the line matches last_word or timeout is reached
-    /// @param lines
+    /// @param lines views of the lines, valid until the next read
     /// @param last_word
     /// @param threshold_ms 0 means no timeout
-    Status readProcess(std::vector<std::string> &lines, std::string_view last_word,
+    /// @return Status::ERR if the engine closed its output
+    Status readProcess(std::vector<std::string_view> &lines, std::string_view last_word,
                        std::chrono::milliseconds threshold) override {
         assert(is_initalized_);
 
-        // Disable blocking
-        fcntl(in_pipe_[0], F_SETFL, fcntl(in_pipe_[0], F_GETFL) | O_NONBLOCK);
-
-        lines.clear();
-
-        std::string currentLine;
-        currentLine.reserve(300);
+        reader_.clear();
 
-        char buffer[4096];
+        // output which arrived after the last_word of the previous read
+        if (consumeLines(last_word)) {
+            reader_.views(lines);
+            return Status::OK;
+        }
 
         struct pollfd pollfds[1];
         pollfds[0].fd     = in_pipe_[0];
         pollfds[0].events = POLLIN;
 
-        // Set up the timeout for poll
-        auto timeoutMillis = threshold;
-        if (timeoutMillis.count() <= 0) {
-            // wait indefinitely
-            timeoutMillis = std::chrono::milliseconds(-1);
-        }
+        const auto deadline = std::chrono::steady_clock::now() + threshold;
 
         // Continue reading output lines until the line matches the specified line or a timeout
         // occurs
         while (true) {
-            const int ret = poll(pollfds, 1, timeoutMillis.count());
+            // wait indefinitely without a threshold
+            int timeout_ms = -1;
+
+            if (threshold.count() > 0) {
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+                timeout_ms = std::max<int>(0, remaining.count());
+            }
+
+            const int ret = pollPipe(pollfds[0], timeout_ms);
 
             if (ret == -1) {
                 throw std::runtime_error("Error: poll() failed");
             } else if (ret == 0) {
                 // timeout
-                lines.emplace_back(currentLine);
+                reader_.store(reader_.partial(), true);
+                reader_.views(lines);
                 return Status::TIMEOUT;
             } else if (pollfds[0].revents & POLLIN) {
-                // input available on the pipe
-                const int bytesRead = read(in_pipe_[0], buffer, sizeof(buffer));
+                // input available on the pipe, read it straight into the line buffer
+                const auto bytesRead = read(in_pipe_[0], reader_.prepare(READ_SIZE), READ_SIZE);
 
                 if (bytesRead == -1) {
                     throw std::runtime_error("Error: read() failed");
                 }
 
-                // Iterate over each character in the buffer
-                for (int i = 0; i < bytesRead; i++) {
-                    // append the character to the current line
-                    if (buffer[i] != '\n') {
-                        currentLine += buffer[i];
-                        continue;
-                    }
-
-                    // If we encounter a newline, add the current line to the vector and reset the
-                    // currentLine
-                    // dont add empty lines
-                    if (!currentLine.empty()) {
-                        fast_chess::Logger::readFromEngine(currentLine, log_name_);
-                        lines.emplace_back(currentLine);
-
-                        if (currentLine.rfind(last_word, 0) == 0) {
-                            return Status::OK;
-                        }
-
-                        currentLine.clear();
-                    }
+                // the engine closed its end of the pipe
+                if (bytesRead == 0) {
+                    reader_.views(lines);
+                    return Status::ERR;
                 }
+
+                reader_.commit(bytesRead);
+
+                if (consumeLines(last_word)) {
+                    reader_.views(lines);
+                    return Status::OK;
+                }
+            } else if (pollfds[0].revents & (POLLHUP | POLLERR | POLLNVAL)) {
+                // hangup without any data left to read, the engine is gone
+                reader_.views(lines);
+                return Status::ERR;
             }
         }
-        return Status::OK;
     }
 
     void writeProcess(const std::string &input) override {
@@ -263,6 +291,70 @@ class Process : public IProcess {
     }
 
    private:
+    /// @brief Creates a pipe which is closed on exec. Otherwise every engine started later would
+    /// inherit the pipes of the other engines and keep them open, so the hangup of an engine
+    /// would go unnoticed while any other engine is alive. dup2 clears the flag on the child's
+    /// stdin and stdout.
+    static int createPipe(int (&fds)[2]) noexcept {
+#ifdef __linux__
+        return pipe2(fds, O_CLOEXEC);
+#else
+        if (pipe(fds) == -1) return -1;
+
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+        return 0;
+#endif
+    }
+
+    /// @brief Waits for the pipe like poll() does. A game which runs as a fiber of the reactor
+    /// is suspended instead, so that its thread can play the other games in the meantime.
+    /// @param pollfd
+    /// @param timeout_ms
+    /// @return
+    static int pollPipe(struct pollfd &pollfd, int timeout_ms) {
+#ifdef __linux__
+        if (auto *reactor = EpollReactor::current()) return reactor->poll(pollfd, timeout_ms);
+#endif
+
+        return poll(&pollfd, 1, timeout_ms);
+    }
+
+    static void closePipe(int &fd) noexcept {
+        if (fd == -1) return;
+
+        close(fd);
+        fd = -1;
+    }
+
+    /// @brief Splits the buffered output into lines and stores them.
+    /// @param last_word
+    /// @return true if a line starting with last_word was found
+    bool consumeLines(std::string_view last_word) {
+        std::string_view line;
+
+        while (reader_.next(line)) {
+            // dont add empty lines
+            if (line.empty()) continue;
+
+            fast_chess::Logger::readFromEngine(line, log_name_);
+            const bool found = line.rfind(last_word, 0) == 0;
+
+            onLine(line);
+            reader_.store(line, found);
+
+            if (found) return true;
+        }
+
+        return false;
+    }
+
+    static constexpr std::size_t READ_SIZE = 4096;
+
+    /// @brief splits the output into lines, keeps everything after the last_word for the next read
+    LineReader reader_;
+
     std::string command_;
     std::string args_;
     std::string log_name_;
@@ -270,7 +362,7 @@ class Process : public IProcess {
     bool is_initalized_ = false;
 
     pid_t process_pid_;
-    int in_pipe_[2], out_pipe_[2];
+    int in_pipe_[2] = {-1, -1}, out_pipe_[2] = {-1, -1};
 
     // exec
     std::unique_ptr<char *[], ArgvDeleter> unique_argv_;
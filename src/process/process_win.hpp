@@ -11,12 +11,14 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
 #include <windows.h>
 
 #include <affinity/affinity.hpp>
+#include <process/line_reader.hpp>
 #include <util/logger/logger.hpp>
 #include <util/thread_vector.hpp>
 
@@ -112,59 +114,43 @@ class Process : public IProcess {
         init(command_, args_, log_name_);
     }
 
+    void setCapture(const fast_chess::CapturePolicy &policy) override {
+        reader_.setCapture(policy);
+    }
+
+    [[nodiscard]] std::size_t peakOutputBytes() const noexcept override {
+        return reader_.peakBytes();
+    }
+
    protected:
     /// @brief Read stdout until the line matches last_word or timeout is reached
-    /// @param lines
+    /// @param lines views of the lines, valid until the next read
     /// @param last_word
     /// @param threshold 0 means no timeout
-    Status readProcess(std::vector<std::string> &lines, std::string_view last_word,
+    Status readProcess(std::vector<std::string_view> &lines, std::string_view last_word,
                        std::chrono::milliseconds threshold) override {
         assert(is_initalized_);
 
         lines.clear();
-        lines.reserve(30);
+        reader_.clear();
 
-        auto readFuture = std::async(std::launch::async, [this, &last_word, &lines]() {
-            std::string currentLine;
-
-            char buffer[4096];
-            DWORD bytesRead;
-            DWORD bytesAvail = 0;
+        auto readFuture = std::async(std::launch::async, [this, &last_word]() {
+            // output which arrived after the last_word of the previous read
+            if (consumeLines(last_word)) return Status::OK;
 
             while (true) {
-                if (!ReadFile(child_std_out_, buffer, sizeof(buffer), &bytesRead, nullptr)) {
+                DWORD bytesRead;
+
+                if (!ReadFile(child_std_out_, reader_.prepare(READ_SIZE), READ_SIZE, &bytesRead,
+                              nullptr)) {
                     return Status::ERR;
                 }
 
                 if (bytesRead <= 0) continue;
 
-                bytesAvail += bytesRead;
-
-                // Iterate over each character in the buffer
-                for (DWORD i = 0; i < bytesRead; i++) {
-                    // If we encounter a newline, add the current line to the vector and reset
-                    // the currentLine on Windows newlines are \r\n. Otherwise, append the
-                    // character to the current line
-                    if (buffer[i] != '\n' && buffer[i] != '\r') {
-                        currentLine += buffer[i];
-                        continue;
-                    }
+                reader_.commit(bytesRead);
 
-                    // don't add empty lines
-                    if (currentLine.empty()) continue;
-
-                    // logging will significantly slow down the reading and lead to engine
-                    // timeouts
-                    fast_chess::Logger::readFromEngine(currentLine, log_name_);
-
-                    lines.emplace_back(currentLine);
-
-                    if (currentLine.rfind(last_word, 0) == 0) {
-                        return Status::OK;
-                    }
-
-                    currentLine.clear();
-                }
+                if (consumeLines(last_word)) return Status::OK;
             }
         });
 
@@ -175,7 +161,12 @@ class Process : public IProcess {
             return Status::TIMEOUT;
         }
 
-        return Status::OK;
+        // Status::ERR if the engine closed its output
+        const auto status = readFuture.get();
+
+        reader_.views(lines);
+
+        return status;
     }
 
     void writeProcess(const std::string &input) override {
@@ -193,6 +184,31 @@ class Process : public IProcess {
     }
 
    private:
+    /// @brief Splits the buffered output into lines and stores them.
+    /// @param last_word
+    /// @return true if a line starting with last_word was found
+    bool consumeLines(std::string_view last_word) {
+        std::string_view line;
+
+        while (reader_.next(line)) {
+            // don't add empty lines
+            if (line.empty()) continue;
+
+            // logging will significantly slow down the reading and lead to engine
+            // timeouts
+            fast_chess::Logger::readFromEngine(line, log_name_);
+
+            const bool found = line.rfind(last_word, 0) == 0;
+
+            onLine(line);
+            reader_.store(line, found);
+
+            if (found) return true;
+        }
+
+        return false;
+    }
+
     void closeHandles() const {
         assert(is_initalized_);
         try {
@@ -215,6 +231,11 @@ class Process : public IProcess {
     PROCESS_INFORMATION pi_;
     HANDLE child_std_out_;
     HANDLE child_std_in_;
+
+    static constexpr DWORD READ_SIZE = 4096;
+
+    /// @brief splits the output into lines, keeps everything after the last_word for the next read
+    LineReader reader_;
 };
 
 #endif
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <tuple>
 #include <vector>
 
+#include <process/capture_policy.hpp>
 #include <types/enums.hpp>
 #include <util/helper.hpp>
 
@@ -69,6 +70,9 @@ struct EngineConfiguration {
 
     bool recover = false;
 
+    // Which info lines are kept while the engine searches
+    CapturePolicy capture;
+
     template <typename T, typename Predicate>
     std::optional<T> getOption(std::string_view option_name, Predicate transform) const {
         const auto it = std::find_if(
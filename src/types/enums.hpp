@@ -3,8 +3,13 @@
 namespace fast_chess {
 enum class NotationType { SAN, LAN, UCI };
 enum class OrderType { RANDOM, SEQUENTIAL };
-enum class FormatType { EPD, PGN, NONE };
+enum class FormatType { EPD, PGN, BIN, NONE };
+enum class DatagenFormat { TEXT, BIN };
 enum class VariantType { STANDARD, FRC };
+enum class PvVerificationType { ALL, LAST, NONE };
+enum class SprtModel { TRINOMIAL, PENTANOMIAL };
+enum class EloType { LOGISTIC, NORMALIZED };
+enum class TournamentType { ROUNDROBIN, GAUNTLET, SWISS };
 enum class OutputType {
     FASTCHESS,
     CUTECHESS,
@@ -10,7 +10,7 @@ namespace fast_chess::options {
 struct Opening {
     std::string file;
     FormatType format = FormatType::NONE;
-    OrderType order   = OrderType::RANDOM;
+    OrderType order   = OrderType::SEQUENTIAL;
     int plies         = 0;
     int start         = 0;
 };
@@ -22,17 +22,43 @@ struct Pgn {
     bool track_nodes      = false;
     bool track_seldepth   = false;
     bool track_nps        = false;
+
+    /// @brief the games are written once this many are buffered or the first one has been
+    /// buffered for flush_time seconds
+    int flush_games   = 1;
+    double flush_time = 1.0;
+    bool fsync        = false;
 };
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_ORDERED_JSON(Pgn, file, notation, track_nodes, track_seldepth,
-                                                track_nps)
+                                                track_nps, flush_games, flush_time, fsync)
+
+/// @brief scored positions for training, written straight from the engine output
+struct Datagen {
+    std::string file;
+    DatagenFormat format = DatagenFormat::TEXT;
+
+    /// @brief positions within the first min_ply plies of the game are skipped
+    int min_ply        = 0;
+    bool skip_checks   = false;
+    bool skip_captures = false;
+    bool skip_mates    = false;
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_ORDERED_JSON(Datagen, file, format, min_ply, skip_checks,
+                                                skip_captures, skip_mates)
 
 struct Sprt {
     double alpha = 0.0;
     double beta  = 0.0;
     double elo0  = 0.0;
     double elo1  = 0.0;
+
+    /// @brief distribution of the outcomes, of single games or of game pairs
+    SprtModel model = SprtModel::TRINOMIAL;
+
+    /// @brief unit of elo0 and elo1
+    EloType elo_type = EloType::LOGISTIC;
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_ORDERED_JSON(Sprt, alpha, beta, elo0, elo1)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_ORDERED_JSON(Sprt, alpha, beta, elo0, elo1, model, elo_type)
 
 struct DrawAdjudication {
     int move_number = 0;
@@ -61,11 +87,25 @@ struct Tournament {
     std::string event_name = "Fast Chess";
     std::string site       = "?";
 
+    /// @brief binary game archive which every finished game is appended to
+    std::string archive;
+
+    Datagen datagen = {};
+
     DrawAdjudication draw     = {};
     ResignAdjudication resign = {};
 
     VariantType variant = VariantType::STANDARD;
 
+    /// @brief who plays against whom, the first engine is the seed of a gauntlet
+    TournamentType type = TournamentType::ROUNDROBIN;
+
+    /// @brief share of the workers when several tests are played by one pool of workers
+    int weight = 1;
+
+    /// @brief which pv lines of the engines are checked for illegal moves
+    PvVerificationType verify_pv = PvVerificationType::ALL;
+
 #ifdef USE_CUTE
     /// @brief output format, fastchess or cutechess
     OutputType output = OutputType::CUTECHESS;
@@ -86,10 +126,15 @@ struct Tournament {
     bool recover      = false;
     bool report_penta = true;
     bool affinity     = true;
+    bool ping         = true;
+
+    /// @brief play the games as fibers of an epoll reactor on a single thread, Linux only
+    bool reactor = false;
 };
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_ORDERED_JSON(Tournament, resign, draw, opening, pgn, sprt,
                                                 event_name, site, output, seed, variant,
                                                 ratinginterval, games, rounds, concurrency,
-                                                overhead, recover, report_penta)
+                                                overhead, recover, report_penta, type, weight,
+                                                datagen, archive, verify_pv, ping, reactor)
 
 }  // namespace fast_chess::options
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace fast_chess::binary_io {
+
+/// @brief Appends the value in little endian byte order.
+/// @tparam T
+/// @param out
+/// @param value
+template <typename T>
+void writeLe(std::string &out, T value) {
+    for (std::size_t i = 0; i < sizeof(T); i++) {
+        out += static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xff);
+    }
+}
+
+/// @brief Reads a little endian value.
+/// @tparam T
+/// @param data
+/// @return
+template <typename T>
+[[nodiscard]] T readLe(const char *data) noexcept {
+    uint64_t value = 0;
+
+    for (std::size_t i = 0; i < sizeof(T); i++) {
+        value |= uint64_t(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+
+    return static_cast<T>(value);
+}
+
+/// @brief Appends the value with 7 bits per byte, small values take a single byte.
+/// @param out
+/// @param value
+inline void writeVarint(std::string &out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+
+    out += static_cast<char>(value);
+}
+
+/// @brief Reads a value written by writeVarint and advances data past it.
+/// @param data
+/// @param end
+/// @return 0 if the data ends in the middle of the value
+[[nodiscard]] inline uint64_t readVarint(const char *&data, const char *end) noexcept {
+    uint64_t value = 0;
+
+    for (int shift = 0; data < end && shift < 64; shift += 7) {
+        const auto byte = static_cast<unsigned char>(*data++);
+        value |= uint64_t(byte & 0x7f) << shift;
+
+        if (!(byte & 0x80)) return value;
+    }
+
+    return 0;
+}
+
+/// @brief Maps signed values to unsigned ones so that small magnitudes stay small.
+[[nodiscard]] inline uint64_t zigzag(int64_t value) noexcept {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+[[nodiscard]] inline int64_t unzigzag(uint64_t value) noexcept {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/// @brief Appends the string with a single length byte, longer strings are cut off.
+/// @param out
+/// @param str
+inline void writeString(std::string &out, std::string_view str) {
+    str = str.substr(0, std::min<std::size_t>(str.size(), 255));
+
+    out += static_cast<char>(str.size());
+    out += str;
+}
+
+/// @brief Reads a string written by writeString and advances data past it.
+/// @param data
+/// @param end
+/// @return
+[[nodiscard]] inline std::string_view readString(const char *&data, const char *end) noexcept {
+    if (data >= end) return {};
+
+    const auto length = static_cast<unsigned char>(*data);
+    data++;
+
+    // a truncated record must not be read past its end
+    const auto size = std::min<std::size_t>(length, end - data);
+    const std::string_view str(data, size);
+    data += size;
+
+    return str;
+}
+
+}  // namespace fast_chess::binary_io
@@ -4,6 +4,7 @@
 #include <deque>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <mutex>
 
 #include <util/scope_guard.hpp>
@@ -34,20 +35,38 @@ class CachePool {
    public:
     template <typename... ARGS>
     [[nodiscard]] CachedEntry<T, ID> &getEntry(const ID &identifier, ARGS &&...arg) {
-        std::lock_guard<std::mutex> lock(access_mutex_);
+        {
+            std::lock_guard<std::mutex> lock(access_mutex_);
 
-        for (auto &entry : cache_) {
-            if (entry.available_ && entry.id == identifier) {
-                entry.available_ = false;
-                return entry;
+            for (auto &entry : cache_) {
+                if (entry->available_ && entry->id == identifier) {
+                    entry->available_ = false;
+                    return *entry;
+                }
             }
         }
 
-        cache_.emplace_back(identifier, std::forward<ARGS>(arg)...);
-        return cache_.back();
+        // Creating an object can take long, like starting an engine. The other users of the pool
+        // do not wait for it, which also lets a game fiber be suspended meanwhile.
+        auto entry = std::make_unique<CachedEntry<T, ID>>(identifier, std::forward<ARGS>(arg)...);
+
+        std::lock_guard<std::mutex> lock(access_mutex_);
+
+        cache_.push_back(std::move(entry));
+        return *cache_.back();
+    }
+
+    /// @brief Calls func(id, object) for every object in the pool, including the ones in use.
+    /// @tparam F
+    /// @param func
+    template <typename F>
+    void forEach(F &&func) {
+        std::lock_guard<std::mutex> lock(access_mutex_);
+
+        for (auto &entry : cache_) func(entry->id, entry->entry_);
     }
 
    private:
-    std::deque<CachedEntry<T, ID>> cache_;
+    std::deque<std::unique_ptr<CachedEntry<T, ID>>> cache_;
     std::mutex access_mutex_;
 };
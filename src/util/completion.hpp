@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace fast_chess {
+
+/// @brief Counts finished tasks and lets a thread sleep until all of them are done. The waiting
+/// thread does not use any cpu time while the tasks run.
+class Completion {
+   public:
+    /// @brief Sets the number of tasks which have to finish.
+    /// @param total
+    void setTotal(uint64_t total) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            total_ = total;
+        }
+
+        cv_.notify_all();
+    }
+
+    /// @brief Marks one task as finished and wakes up the waiting thread.
+    /// @return the number of finished tasks
+    uint64_t finish() {
+        uint64_t done;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done = ++done_;
+        }
+
+        cv_.notify_all();
+
+        return done;
+    }
+
+    [[nodiscard]] uint64_t done() const noexcept { return done_; }
+    [[nodiscard]] uint64_t total() const noexcept { return total_; }
+
+    /// @brief Blocks until all tasks have finished or stop() returns true. Wakes up once every
+    /// interval to call tick() and to check stop(), which might be set by a signal handler that
+    /// can not notify the waiting thread.
+    /// @tparam Stop
+    /// @tparam Tick
+    /// @param interval
+    /// @param stop
+    /// @param tick called without holding the lock
+    template <typename Stop, typename Tick>
+    void wait(std::chrono::milliseconds interval, Stop &&stop, Tick &&tick) {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        auto next_tick = std::chrono::steady_clock::now() + interval;
+
+        while (done_ < total_ && !stop()) {
+            if (cv_.wait_until(lock, next_tick) == std::cv_status::no_timeout) continue;
+
+            lock.unlock();
+            tick();
+            lock.lock();
+
+            next_tick = std::chrono::steady_clock::now() + interval;
+        }
+    }
+
+   private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+    // only modified while holding the mutex, so that no wake-up is lost
+    std::atomic<uint64_t> done_  = 0;
+    std::atomic<uint64_t> total_ = 0;
+};
+
+}  // namespace fast_chess
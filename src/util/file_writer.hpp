@@ -1,24 +1,155 @@
 #pragma once
 
-#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
 #include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
+
+#ifdef _WIN64
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <util/mpsc_queue.hpp>
 
 namespace fast_chess {
 
-/// @brief Writes to a file in a thread safe manner.
+/// @brief When the buffered writes reach the file.
+struct FlushPolicy {
+    /// @brief write once this many entries are buffered
+    int entries = 1;
+
+    /// @brief write at the latest this long after the first buffered entry
+    std::chrono::milliseconds interval = std::chrono::milliseconds(1000);
+
+    /// @brief sync the file to the storage device after every write
+    bool fsync = false;
+};
+
+/// @brief Writes to a file in a thread safe manner. Callers only queue the data, a writer thread
+/// collects it and hands it to the file in as few write calls as the flush policy allows. A slow
+/// disk therefore never holds up the thread which produced the data.
 class FileWriter {
    public:
-    FileWriter(const std::string &filename) { file_.open(filename, std::ios::app); }
+    /// @brief Opens the file for appending.
+    /// @param filename
+    /// @param policy
+    /// @param binary write the data as is, otherwise in text mode which converts the line endings
+    /// on Windows
+    FileWriter(const std::string &filename, const FlushPolicy &policy = {}, bool binary = false)
+        : policy_(policy) {
+        file_ = std::fopen(filename.c_str(), binary ? "ab" : "a");
+
+        if (file_ == nullptr) {
+            throw std::runtime_error("Error; Could not open file: " + filename + " (" +
+                                     std::strerror(errno) + ")");
+        }
+
+        // every batch is written with a single call, no need for a second buffer
+        std::setvbuf(file_, nullptr, _IONBF, 0);
+
+        thread_ = std::thread([this] { run(); });
+    }
+
+    FileWriter(const FileWriter &)            = delete;
+    FileWriter &operator=(const FileWriter &) = delete;
+
+    /// @brief Writes everything which has been queued before closing the file.
+    ~FileWriter() {
+        stop_ = true;
+        wake();
 
-    void write(const std::string &data) {
-        std::lock_guard<std::mutex> lock(file_mutex_);
-        file_ << data;
+        thread_.join();
+        std::fclose(file_);
+    }
+
+    /// @brief Queues the data, returns without waiting for the file.
+    /// @param data
+    void write(std::string data) {
+        queue_.push(std::move(data));
+
+        if (sleeping_) wake();
     }
 
    private:
-    std::ofstream file_;
-    std::mutex file_mutex_;
+    using clock = std::chrono::steady_clock;
+
+    void wake() {
+        // taking the lock makes sure the writer is either waiting already or sees the new data
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_one();
+    }
+
+    void run() {
+        std::string batch;
+        std::string data;
+
+        int entries = 0;
+        auto first  = clock::now();
+
+        while (true) {
+            while (queue_.pop(data)) {
+                if (entries++ == 0) first = clock::now();
+                batch += data;
+            }
+
+            const bool stop = stop_;
+
+            if (entries > 0 && (stop || entries >= policy_.entries ||
+                                clock::now() - first >= policy_.interval)) {
+                flush(batch);
+                batch.clear();
+                entries = 0;
+            }
+
+            // the queue has been drained after stop was set
+            if (stop) return;
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleeping_ = true;
+
+            const auto ready = [this] { return stop_ || !queue_.empty(); };
+
+            if (entries > 0) {
+                cv_.wait_until(lock, first + policy_.interval, ready);
+            } else {
+                cv_.wait(lock, ready);
+            }
+
+            sleeping_ = false;
+        }
+    }
+
+    void flush(const std::string &batch) {
+        std::fwrite(batch.data(), 1, batch.size(), file_);
+
+        if (!policy_.fsync) return;
+
+#ifdef _WIN64
+        _commit(_fileno(file_));
+#else
+        fsync(fileno(file_));
+#endif
+    }
+
+    FlushPolicy policy_;
+    std::FILE *file_ = nullptr;
+
+    MpscQueue<std::string> queue_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic_bool sleeping_ = false;
+    std::atomic_bool stop_     = false;
+
+    std::thread thread_;
 };
 
 }  // namespace fast_chess
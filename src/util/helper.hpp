@@ -13,13 +13,18 @@ namespace fast_chess {
 /*
 Modified version of the NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE macro in nlohmann's json lib.
 ordered_json type conversion is not yet supported, though we only have to change the type.
+Missing keys keep the current value of the member, so config files written by older versions
+still load.
 */
+#define FAST_CHESS_JSON_FROM_OR_KEEP(v1) \
+    nlohmann_json_t.v1 = nlohmann_json_j.value(#v1, nlohmann_json_t.v1);
+
 #define NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_ORDERED_JSON(Type, ...)                                \
     inline void to_json(nlohmann::ordered_json &nlohmann_json_j, const Type &nlohmann_json_t) {   \
         NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_TO, __VA_ARGS__))                  \
     }                                                                                             \
     inline void from_json(const nlohmann::ordered_json &nlohmann_json_j, Type &nlohmann_json_t) { \
-        NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, __VA_ARGS__))                \
+        NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(FAST_CHESS_JSON_FROM_OR_KEEP, __VA_ARGS__))      \
     }
 }  // namespace fast_chess
 
@@ -19,7 +19,7 @@ void Logger::openFile(const std::string &file) {
 
 void Logger::setLevel(Level level) { Logger::level_ = level; }
 
-void Logger::writeToEngine(const std::string &msg, const std::string &name) {
+void Logger::writeToEngine(std::string_view msg, const std::string &name) {
     if (!should_log_) {
         return;
     }
@@ -34,7 +34,7 @@ void Logger::writeToEngine(const std::string &msg, const std::string &name) {
     log_ << ss.str() << std::flush;
 }
 
-void Logger::readFromEngine(const std::string &msg, const std::string &name) {
+void Logger::readFromEngine(std::string_view msg, const std::string &name) {
     if (!should_log_) {
         return;
     }
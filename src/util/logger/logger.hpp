@@ -6,6 +6,7 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
 
 #include <util/date.hpp>
@@ -52,9 +53,9 @@ class Logger {
         log_ << file_ss.str() << std::flush;
     }
 
-    static void writeToEngine(const std::string &msg, const std::string &name);
+    static void writeToEngine(std::string_view msg, const std::string &name);
 
-    static void readFromEngine(const std::string &msg, const std::string &name);
+    static void readFromEngine(std::string_view msg, const std::string &name);
 
     static std::atomic_bool should_log_;
 
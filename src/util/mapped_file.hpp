@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN64
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fast_chess {
+
+/// @brief Read only memory mapping of a whole file. The pages are backed by the page cache, so
+/// processes which map the same file share one physical copy of it.
+class MappedFile {
+   public:
+    MappedFile() = default;
+
+    /// @brief Maps the file, throws if it can not be opened.
+    /// @param path
+    explicit MappedFile(const std::string &path) {
+#ifdef _WIN64
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Error; Could not open file: " + path);
+        }
+
+        LARGE_INTEGER size;
+        GetFileSizeEx(file_, &size);
+        size_ = static_cast<std::size_t>(size.QuadPart);
+
+        // an empty file can not be mapped
+        if (size_ == 0) return;
+
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (mapping_ == nullptr) {
+            throw std::runtime_error("Error; Could not map file: " + path);
+        }
+
+        data_ = static_cast<const char *>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+#else
+        const int fd = open(path.c_str(), O_RDONLY);
+
+        if (fd == -1) {
+            throw std::runtime_error("Error; Could not open file: " + path);
+        }
+
+        struct stat st;
+        fstat(fd, &st);
+        size_ = static_cast<std::size_t>(st.st_size);
+
+        // an empty file can not be mapped
+        if (size_ == 0) {
+            close(fd);
+            return;
+        }
+
+        void *data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+
+        // the mapping stays valid after the file is closed
+        close(fd);
+
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("Error; Could not map file: " + path);
+        }
+
+        data_ = static_cast<const char *>(data);
+#endif
+
+        if (data_ == nullptr) {
+            throw std::runtime_error("Error; Could not map file: " + path);
+        }
+    }
+
+    MappedFile(const MappedFile &)            = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept { swap(other); }
+
+    MappedFile &operator=(MappedFile &&other) noexcept {
+        MappedFile tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    ~MappedFile() {
+#ifdef _WIN64
+        if (data_ != nullptr) UnmapViewOfFile(data_);
+        if (mapping_ != nullptr) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+        if (data_ != nullptr) munmap(const_cast<char *>(data_), size_);
+#endif
+    }
+
+    /// @brief The content of the file.
+    /// @return
+    [[nodiscard]] std::string_view view() const noexcept { return {data_, size_}; }
+
+   private:
+    void swap(MappedFile &other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+#ifdef _WIN64
+        std::swap(file_, other.file_);
+        std::swap(mapping_, other.mapping_);
+#endif
+    }
+
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+
+#ifdef _WIN64
+    HANDLE file_    = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+}  // namespace fast_chess
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace fast_chess {
+
+/// @brief Unbounded lock free queue for many producers and a single consumer. Pushing is a
+/// single atomic exchange, so producers never wait for each other or for the consumer.
+template <typename T>
+class MpscQueue {
+   public:
+    MpscQueue() : head_(new Node()), tail_(head_.load()) {}
+
+    MpscQueue(const MpscQueue &)            = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    ~MpscQueue() {
+        while (tail_ != nullptr) {
+            Node *next = tail_->next.load();
+            delete tail_;
+            tail_ = next;
+        }
+    }
+
+    /// @brief Thread safe.
+    /// @param value
+    void push(T value) {
+        Node *node  = new Node();
+        node->value = std::move(value);
+
+        Node *prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node);
+    }
+
+    /// @brief Only the consumer may call this.
+    /// @param value
+    /// @return false if the queue is empty
+    [[nodiscard]] bool pop(T &value) {
+        Node *next = tail_->next.load(std::memory_order_acquire);
+
+        if (next == nullptr) return false;
+
+        value = std::move(next->value);
+
+        // the popped node becomes the new dummy in front of the queue
+        delete tail_;
+        tail_ = next;
+
+        return true;
+    }
+
+    /// @brief Only the consumer may call this. A push which is still in progress counts as empty.
+    /// @return
+    [[nodiscard]] bool empty() const { return tail_->next.load() == nullptr; }
+
+   private:
+    struct Node {
+        std::atomic<Node *> next = nullptr;
+        T value;
+    };
+
+    /// @brief the node which was pushed last
+    std::atomic<Node *> head_;
+
+    /// @brief the dummy in front of the next node to pop, owned by the consumer
+    Node *tail_;
+};
+
+}  // namespace fast_chess
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace fast_chess {
+
+/// @brief A seeded bijection of [0, size), evaluated one index at a time. A small Feistel network
+/// permutes the smallest domain of 4^k elements which covers size, indices outside of [0, size)
+/// are encrypted again until they fall inside (cycle walking). Takes O(1) memory, no matter how
+/// large the range is.
+class IndexPermutation {
+   public:
+    IndexPermutation() = default;
+
+    /// @brief
+    /// @param size
+    /// @param seed the same seed always gives the same permutation
+    IndexPermutation(uint64_t size, uint64_t seed) : size_(size) {
+        while (half_bits_ < 32 && (uint64_t(1) << (2 * half_bits_)) < size) half_bits_++;
+
+        mask_ = (uint64_t(1) << half_bits_) - 1;
+
+        for (auto &key : keys_) key = splitmix64(seed);
+    }
+
+    /// @brief The index at position idx of the permutation.
+    /// @param idx has to be smaller than size
+    /// @return
+    [[nodiscard]] uint64_t operator()(uint64_t idx) const noexcept {
+        // the domain is less than 4 times as large, so only a few rounds are expected
+        do {
+            idx = encrypt(idx);
+        } while (idx >= size_);
+
+        return idx;
+    }
+
+    [[nodiscard]] uint64_t size() const noexcept { return size_; }
+
+   private:
+    static constexpr int ROUNDS = 4;
+
+    [[nodiscard]] static uint64_t splitmix64(uint64_t &state) noexcept {
+        uint64_t z = (state += 0x9e3779b97f4a7c15);
+        z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z          = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    [[nodiscard]] uint64_t encrypt(uint64_t idx) const noexcept {
+        uint64_t left  = idx >> half_bits_;
+        uint64_t right = idx & mask_;
+
+        for (auto key : keys_) {
+            const uint64_t next = left ^ (splitmix64(key += right) & mask_);
+
+            left  = right;
+            right = next;
+        }
+
+        return (left << half_bits_) | right;
+    }
+
+    uint64_t size_ = 0;
+
+    /// @brief each half of an index has this many bits
+    int half_bits_ = 0;
+    uint64_t mask_ = 0;
+
+    std::array<uint64_t, ROUNDS> keys_ = {};
+};
+
+}  // namespace fast_chess
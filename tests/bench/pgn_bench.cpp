@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <pgn/pgn_reader.hpp>
+
+using namespace fast_chess;
+
+/// @brief Time to parse a large PGN book completely, with one thread and split into chunks which
+/// are parsed concurrently. The book is tests/data/openings.pgn replicated in memory.
+int main(int argc, char const *argv[]) {
+    const std::size_t megabytes = argc > 1 ? std::stoul(argv[1]) : 64;
+    const std::size_t max_threads =
+        argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::ifstream file("tests/data/openings.pgn");
+
+    if (!file) {
+        std::cerr << "Run from the repository root, tests/data/openings.pgn is missing\n";
+        return 1;
+    }
+
+    std::stringstream ss;
+    ss << file.rdbuf();
+
+    const std::string games = ss.str() + "\n";
+
+    std::string pgn;
+    pgn.reserve(megabytes << 20);
+    while (pgn.size() < (megabytes << 20)) pgn += games;
+
+    using clock = std::chrono::steady_clock;
+
+    std::cout << "parsing " << pgn.size() / (1 << 20) << " MiB\n";
+
+    double single = 0;
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        const auto t0       = clock::now();
+        const auto openings = PgnReader::parseGames(pgn, threads);
+        const auto t1       = clock::now();
+
+        const double seconds = std::chrono::duration<double>(t1 - t0).count();
+        if (threads == 1) single = seconds;
+
+        std::cout << std::setw(3) << threads << " threads " << std::fixed << std::setprecision(3)
+                  << std::setw(8) << seconds << " s " << std::setw(10) << openings.size()
+                  << " games " << std::setprecision(2) << std::setw(6) << single / seconds
+                  << "x\n";
+    }
+
+    return 0;
+}
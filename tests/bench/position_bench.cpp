@@ -0,0 +1,71 @@
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <matchmaking/match/position_buffer.hpp>
+#include <matchmaking/player.hpp>
+#include <types/match_data.hpp>
+
+using namespace fast_chess;
+
+/// @brief Harness cost of the uci position command per ply. Compares rebuilding the command from
+/// all moves before every ply with appending one move per ply.
+int main(int argc, char const *argv[]) {
+    const int plies = argc > 1 ? std::stoi(argv[1]) : 300;
+    const int games = argc > 2 ? std::stoi(argv[2]) : 2000;
+
+    const std::string fen = "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1";
+    const std::vector<std::string> moves = {"e7e5", "g1f3", "b8c6", "f1b5", "a7a6", "b5a4",
+                                            "g8f6", "e1g1", "f8e7", "f1e1", "b7b5", "a7a8q"};
+
+    using clock = std::chrono::steady_clock;
+
+    std::size_t checksum = 0;
+
+    // what Match::playMove did before: copy every move and rebuild the command
+    const auto t0 = clock::now();
+    for (int g = 0; g < games; g++) {
+        std::vector<MoveData> played;
+
+        for (int ply = 0; ply < plies; ply++) {
+            played.emplace_back(moves[ply % moves.size()], "0.00", 0, 0, 0, 0, 0);
+
+            std::vector<std::string> uci_moves;
+            for (const auto &data : played) uci_moves.push_back(data.move);
+
+            checksum += Player::buildPositionInput(uci_moves, fen).size();
+        }
+    }
+    const auto t1 = clock::now();
+
+    // one move appended per ply
+    for (int g = 0; g < games; g++) {
+        std::vector<MoveData> played;
+
+        PositionBuffer position;
+        position.reset(fen);
+
+        for (int ply = 0; ply < plies; ply++) {
+            played.emplace_back(moves[ply % moves.size()], "0.00", 0, 0, 0, 0, 0);
+
+            position.push(played.back().move);
+            checksum -= position.get().size();
+        }
+    }
+    const auto t2 = clock::now();
+
+    const auto per_ply = [&](auto duration) {
+        return std::chrono::duration<double, std::nano>(duration).count() / (double(games) * plies);
+    };
+
+    std::cout << std::fixed << std::setprecision(1)                  //
+              << plies << " plies, " << games << " games\n"           //
+              << "rebuild:     " << per_ply(t1 - t0) << " ns/ply\n"  //
+              << "incremental: " << per_ply(t2 - t1) << " ns/ply\n"  //
+              << (checksum == 0 ? "" : "checksum mismatch\n") << std::flush;
+
+    return checksum == 0 ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <chess.hpp>
+
+#include <matchmaking/match/pv_verifier.hpp>
+#include <util/helper.hpp>
+
+using namespace fast_chess;
+
+namespace {
+
+/// @brief The moves after " pv ", the benchmark does not depend on the info parser.
+std::string_view pvOf(std::string_view line) {
+    const auto pos = line.find(" pv ");
+    return pos == std::string_view::npos ? std::string_view{} : line.substr(pos + 4);
+}
+
+}  // namespace
+
+/// @brief Harness cost of checking the pv lines of one move. Compares copying the board for every
+/// pv line with making and unmaking the moves on a single board.
+int main(int argc, char const *argv[]) {
+    const int lines = argc > 1 ? std::stoi(argv[1]) : 40;
+    const int moves = argc > 2 ? std::stoi(argv[2]) : 20000;
+
+    // a game in progress, the copy of the board includes its history
+    chess::Board board;
+    for (const auto *uci : {"e2e4", "e7e5", "g1f3", "b8c6", "f1b5", "a7a6", "b5a4", "g8f6", "e1g1",
+                            "f8e7", "f1e1", "b7b5", "a4b3", "d7d6", "c2c3", "e8g8", "h2h3",
+                            "c6a5", "b3c2", "c7c5", "d2d4", "d8c7", "b1d2", "c5d4", "c3d4"}) {
+        board.makeMove(chess::uci::uciToMove(board, uci));
+    }
+
+    const std::string pv =
+        "a5c6 d2b3 a6a5 c1e3 a5a4 b3d2 c8d7 a1c1 c7b7 d2f1 f8c8 c2b1 b5b4 e3d2 c6d4 f3d4 e5d4 "
+        "d2b4";
+
+    // one line per depth, each with a pv as deep as the iteration
+    std::vector<std::string> output;
+    for (int depth = 1; depth <= lines; depth++) {
+        output.push_back("info depth " + std::to_string(depth) + " seldepth " +
+                         std::to_string(depth + 4) +
+                         " score cp 23 nodes 123456 nps 1000000 hashfull 10 tbhits 0 time 100 pv " +
+                         pv);
+    }
+
+    using clock = std::chrono::steady_clock;
+
+    std::size_t checksum = 0;
+
+    // what Match::verifyPvLines did before: split every line and check it on a copy of the board
+    const auto t0 = clock::now();
+    for (int m = 0; m < moves; m++) {
+        for (const auto &info : output) {
+            const auto tokens = str_utils::splitString(info, ' ');
+            if (!str_utils::contains(tokens, "pv")) continue;
+
+            auto tmp      = board;
+            auto it_start = std::find(tokens.begin(), tokens.end(), "pv") + 1;
+
+            chess::Movelist legal;
+
+            std::for_each(it_start, tokens.end(), [&](const auto &token) {
+                chess::movegen::legalmoves(legal, tmp);
+
+                const auto move = chess::uci::uciToMove(tmp, token);
+                checksum += std::find(legal.begin(), legal.end(), move) == legal.end();
+
+                tmp.makeMove(move);
+            });
+        }
+    }
+    const auto t1 = clock::now();
+
+    // every pv line on one board with make/unmake
+    PvVerifier verifier;
+    for (int m = 0; m < moves; m++) {
+        for (const auto &info : output) {
+            checksum += verifier.verify(board, pvOf(info)).size();
+        }
+    }
+    const auto t2 = clock::now();
+
+    // only the pv of the last line
+    for (int m = 0; m < moves; m++) {
+        checksum += verifier.verify(board, pvOf(output.back())).size();
+    }
+    const auto t3 = clock::now();
+
+    const auto per_move = [moves](auto start, auto end) {
+        return std::chrono::duration<double, std::micro>(end - start).count() / moves;
+    };
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "pv lines per move: " << lines << ", moves: " << moves << "\n";
+    std::cout << "copy + split all:  " << per_move(t0, t1) << " us/move\n";
+    std::cout << "make/unmake all:   " << per_move(t1, t2) << " us/move\n";
+    std::cout << "make/unmake last:  " << per_move(t2, t3) << " us/move\n";
+    std::cout << "checksum: " << checksum << "\n";
+
+    return 0;
+}
@@ -25,4 +25,19 @@ TEST_SUITE("Elo Calculation Tests") {
         CHECK(elo.getDiff(1164, 1267, 3049) == doctest::Approx(-6.53).epsilon(0.01));
         CHECK(elo.getError(1164, 1267, 3049) == doctest::Approx(6.12).epsilon(0.01));
     }
+
+    TEST_CASE("Normalized elo") {
+        Stats stats(135, 110, 175);
+
+        CHECK(Elo::getNormalizedElo(stats) == "27.16 +/- 33.18");
+
+        stats.penta_LL = 5;
+        stats.penta_LD = 30;
+        stats.penta_WL = 70;
+        stats.penta_DD = 50;
+        stats.penta_WD = 45;
+        stats.penta_WW = 10;
+
+        CHECK(Elo::getNormalizedElo(stats) == "36.89 +/- 33.18");
+    }
 }
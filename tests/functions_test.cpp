@@ -1,4 +1,16 @@
+#include <util/completion.hpp>
+#include <util/file_writer.hpp>
 #include <util/helper.hpp>
+#include <util/permutation.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "doctest/doctest.hpp"
 
@@ -17,4 +29,104 @@ TEST_SUITE("Standalone Function Tests") {
         CHECK(str_utils::contains("-engine", "e"));
         CHECK(str_utils::contains("info string depth 10", "depth"));
     }
+
+    TEST_CASE("Testing the Completion class") {
+        Completion completion;
+        completion.setTotal(3);
+
+        std::thread worker([&completion] {
+            for (int i = 0; i < 3; i++) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                completion.finish();
+            }
+        });
+
+        int ticks = 0;
+        completion.wait(std::chrono::milliseconds(5), [] { return false; }, [&ticks] { ticks++; });
+
+        worker.join();
+
+        CHECK(completion.done() == 3);
+        CHECK(ticks > 0);
+
+        // a stop request ends the wait before all tasks are done
+        std::atomic_bool stop = false;
+        completion.setTotal(4);
+
+        std::thread stopper([&stop] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            stop = true;
+        });
+
+        completion.wait(std::chrono::milliseconds(5), [&stop] { return stop.load(); }, [] {});
+
+        stopper.join();
+
+        CHECK(completion.done() == 3);
+    }
+
+    TEST_CASE("Testing the IndexPermutation class") {
+        for (uint64_t size : {1, 2, 3, 4, 5, 17, 1000, 4096, 4097}) {
+            const IndexPermutation order(size, 42);
+
+            std::vector<bool> seen(size, false);
+
+            for (uint64_t i = 0; i < size; i++) {
+                const auto idx = order(i);
+
+                REQUIRE(idx < size);
+                CHECK(!seen[idx]);
+
+                seen[idx] = true;
+            }
+        }
+
+        const IndexPermutation a(1000, 1), b(1000, 1), c(1000, 2);
+
+        int moved = 0, differ = 0;
+        for (uint64_t i = 0; i < 1000; i++) {
+            CHECK(a(i) == b(i));
+
+            moved += a(i) != i;
+            differ += a(i) != c(i);
+        }
+
+        CHECK(moved > 900);
+        CHECK(differ > 900);
+    }
+
+    TEST_CASE("Testing the FileWriter class") {
+        const std::string file = "tests/data/file_writer_test.txt";
+        std::remove(file.c_str());
+
+        {
+            FlushPolicy policy;
+            policy.entries = 16;
+
+            FileWriter writer(file, policy);
+
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; t++) {
+                threads.emplace_back([&writer, t] {
+                    for (int i = 0; i < 250; i++) {
+                        writer.write(std::to_string(t * 1000 + i) + "\n");
+                    }
+                });
+            }
+
+            for (auto &thread : threads) thread.join();
+        }
+
+        // everything queued before the writer was destroyed has been written, in one piece
+        std::ifstream in(file);
+        std::set<std::string> lines;
+
+        for (std::string line; std::getline(in, line);) lines.insert(line);
+
+        CHECK(lines.size() == 1000);
+        CHECK(lines.count("0") == 1);
+        CHECK(lines.count("3249") == 1);
+
+        std::remove(file.c_str());
+    }
 }
\ No newline at end of file
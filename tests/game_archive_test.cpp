@@ -0,0 +1,132 @@
+#include <archive/game_archive.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include <pgn/pgn_builder.hpp>
+
+#include "doctest/doctest.hpp"
+
+namespace fast_chess {
+TEST_SUITE("Game Archive Tests") {
+    TEST_CASE("Archived games are written back as the same pgn") {
+        MatchData match_data;
+        match_data.players.first.config.name = "engine1";
+        match_data.players.first.color       = chess::Color::BLACK;
+        match_data.players.first.result      = chess::GameResult::WIN;
+
+        match_data.players.second.config.name = "engine2";
+        match_data.players.second.color       = chess::Color::WHITE;
+        match_data.players.second.result      = chess::GameResult::LOSE;
+
+        match_data.players.first.config.limit.tc.time       = 10000;
+        match_data.players.first.config.limit.tc.increment  = 100;
+        match_data.players.second.config.limit.tc.time      = 10000;
+        match_data.players.second.config.limit.tc.increment = 100;
+
+        match_data.moves = {MoveData("e2e4", "0.00", 0, 0, 0, 0, 0),
+                            MoveData("e7e5", "-0.35", 430, 15, 3, -35, 120000),
+                            MoveData("g1f3", "+M3", 310, 16, 24, 3, 81234),
+                            MoveData("e1e3", "0.00", 1821, 0, 0, 0, 0, false)};
+
+        match_data.moves[2].nps = 262000;
+
+        match_data.fen         = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+        match_data.date        = "2024-01-01";
+        match_data.start_time  = "2024-01-01T10:00:00 +0000";
+        match_data.end_time    = "2024-01-01T10:00:03 +0000";
+        match_data.duration    = "00:00:03";
+        match_data.reason      = "engine2 makes an illegal move";
+        match_data.termination = MatchTermination::ILLEGAL_MOVE;
+
+        options::Tournament options;
+        options.site               = "localhost";
+        options.pgn.track_nodes    = true;
+        options.pgn.track_seldepth = true;
+        options.pgn.track_nps      = true;
+
+        const std::string file = "game_archive_test.fcga";
+
+        {
+            std::ofstream out(file, std::ios::binary);
+            out << GameArchive::header() << GameArchive::encode(match_data, options, 7)
+                << GameArchive::encode(match_data, options, 8);
+
+            // a record which was cut off while writing
+            out << GameArchive::encode(match_data, options, 9).substr(0, 20);
+        }
+
+        const GameArchive archive(file);
+
+        REQUIRE(archive.size() == 2);
+
+        const auto game = archive[1];
+
+        CHECK(game.round_id == 8);
+        CHECK(game.site == "localhost");
+        CHECK(game.match.players.first.color == chess::Color::BLACK);
+        CHECK(game.match.players.second.color == chess::Color::WHITE);
+        CHECK(game.match.moves[2].nodes == 81234);
+        CHECK(game.match.moves[3].move == "e1e3");
+        CHECK_FALSE(game.match.moves[3].legal);
+
+        options::Tournament decoded_options = options;
+        decoded_options.event_name          = game.event_name;
+
+        CHECK(PgnBuilder(game.match, decoded_options, game.round_id).get() ==
+              PgnBuilder(match_data, options, 8).get());
+
+        std::remove(file.c_str());
+    }
+
+    TEST_CASE("Appending to an archive drops an incomplete record") {
+        MatchData match_data;
+        match_data.fen   = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+        match_data.moves = {MoveData("e2e4", "+0.20", 10, 5, 5, 20, 1000)};
+
+        const options::Tournament options;
+        const std::string file = "game_archive_append_test.fcga";
+
+        std::remove(file.c_str());
+
+        // a new archive starts with the header
+        GameArchive::prepareAppend(file);
+
+        {
+            std::ofstream out(file, std::ios::binary | std::ios::app);
+            out << GameArchive::encode(match_data, options, 1)
+                << GameArchive::encode(match_data, options, 2).substr(0, 20);
+        }
+
+        GameArchive::prepareAppend(file);
+
+        {
+            std::ofstream out(file, std::ios::binary | std::ios::app);
+            out << GameArchive::encode(match_data, options, 3);
+        }
+
+        {
+            const GameArchive archive(file);
+
+            REQUIRE(archive.size() == 2);
+            CHECK(archive[0].round_id == 1);
+            CHECK(archive[1].round_id == 3);
+        }
+
+        // a record whose size does not cover its fixed fields
+        {
+            std::ofstream out(file, std::ios::binary | std::ios::app);
+            out << std::string("\x03\0\0\0\0\0\0", 7);
+        }
+
+        {
+            const GameArchive archive(file);
+
+            REQUIRE(archive.size() == 3);
+            CHECK_THROWS(static_cast<void>(archive[2]));
+        }
+
+        std::remove(file.c_str());
+    }
+}
+}  // namespace fast_chess
@@ -0,0 +1,89 @@
+#include <matchmaking/tournament/roundrobin/match_generator.hpp>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "doctest/doctest.hpp"
+
+namespace fast_chess {
+TEST_SUITE("Match Generator") {
+    TEST_CASE("Generate all games of a round robin") {
+        options::Opening opening;
+        opening.file   = "tests/data/openings.epd";
+        opening.format = FormatType::EPD;
+
+        OpeningBook book(opening);
+
+        MatchGenerator generator(book, {{0, 1}, {0, 2}, {1, 2}}, 3, 2);
+
+        std::vector<MatchGenerator::Game> games;
+        while (const auto game = generator.next()) games.push_back(game.value());
+
+        CHECK(games.size() == 3 * 3 * 2);
+        CHECK(!generator.next().has_value());
+
+        std::set<std::string> fens;
+
+        for (std::size_t i = 0; i < games.size(); i += 2) {
+            const auto& first  = games[i];
+            const auto& second = games[i + 1];
+
+            // both games of a round are played from the same opening with swapped colors
+            CHECK(first.opening.fen == second.opening.fen);
+            CHECK(!first.swapped);
+            CHECK(second.swapped);
+            CHECK(first.first == second.first);
+            CHECK(first.second == second.second);
+            CHECK(first.round_id == second.round_id);
+            CHECK(first.game_id == first.round_id * 2 + 1);
+            CHECK(second.game_id == second.round_id * 2 + 2);
+
+            fens.insert(first.opening.fen);
+        }
+
+        // every round gets its own opening
+        CHECK(fens.size() == 9);
+
+        // each pairing plays all of its rounds before the next one
+        CHECK(games[0].first == 0);
+        CHECK(games[0].second == 1);
+        CHECK(games[5].round_id == 2);
+        CHECK(games[6].second == 2);
+        CHECK(games[6].round_id == 0);
+        CHECK(games[17].first == 1);
+    }
+
+    TEST_CASE("Interleave the pairings of a gauntlet") {
+        options::Opening opening;
+        opening.file   = "tests/data/openings.epd";
+        opening.format = FormatType::EPD;
+
+        OpeningBook book(opening);
+
+        MatchGenerator generator(book, {{0, 1}, {0, 2}, {0, 3}}, 2, 2, true);
+
+        std::vector<MatchGenerator::Game> games;
+        while (const auto game = generator.next()) games.push_back(game.value());
+
+        REQUIRE(games.size() == 3 * 2 * 2);
+
+        for (std::size_t i = 0; i < games.size(); i++) {
+            const auto& game = games[i];
+
+            // every opponent plays a round before the next round starts
+            CHECK(game.first == 0);
+            CHECK(game.second == (i / 2) % 3 + 1);
+            CHECK(game.round_id == i / 2);
+            CHECK(game.game_id == i + 1);
+            CHECK(game.swapped == (i % 2 == 1));
+
+            // all opponents get the same opening in a round
+            CHECK(game.opening.fen == games[i / 6 * 6].opening.fen);
+        }
+
+        CHECK(games[0].opening.fen != games[6].opening.fen);
+        CHECK(games[0].round_result != games[2].round_result);
+    }
+}
+}  // namespace fast_chess
@@ -0,0 +1,280 @@
+#include <matchmaking/book/bin_book.hpp>
+#include <matchmaking/book/epd_book.hpp>
+#include <matchmaking/book/opening_book.hpp>
+#include <matchmaking/book/pgn_book.hpp>
+#include <pgn/pgn_reader.hpp>
+#include <util/binary_io.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+
+#include "doctest/doctest.hpp"
+
+namespace fast_chess {
+TEST_SUITE("Opening Book") {
+    TEST_CASE("Index an EPD book") {
+        const std::string file = "tests/data/epd_book_test.epd";
+
+        {
+            std::ofstream out(file, std::ios::binary);
+            out << "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1\n"
+                << "\n"
+                << "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2\r\n"
+                << "\r\n"
+                << "8/8/8/8/8/8/8/K6k w - - 0 1";
+        }
+
+        {
+            const EpdBook book(file);
+
+            REQUIRE(book.size() == 3);
+            CHECK(book[0] == "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1");
+            CHECK(book[1] == "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2");
+            CHECK(book[2] == "8/8/8/8/8/8/8/K6k w - - 0 1");
+        }
+
+        std::remove(file.c_str());
+    }
+
+    TEST_CASE("Fetch openings from an EPD book") {
+        options::Opening config;
+        config.file   = "tests/data/openings.epd";
+        config.format = FormatType::EPD;
+
+        OpeningBook book(config);
+
+        for (int i = 0; i < 200; i++) {
+            const auto opening = book.fetch();
+
+            CHECK(opening.moves.empty());
+            CHECK(opening.stm == chess::Board(opening.fen).sideToMove());
+        }
+    }
+
+    TEST_CASE("Lazy PGN book matches the parsed PGN") {
+        for (const auto* file : {"tests/data/test.pgn", "tests/data/openings.pgn"}) {
+            const auto openings = PgnReader(file).getOpenings();
+            const PgnBook book(file);
+
+            REQUIRE(book.size() == openings.size());
+
+            for (std::size_t i = 0; i < book.size(); i++) {
+                const auto opening = book[i];
+
+                CHECK(opening.fen == openings[i].fen);
+                CHECK(opening.moves == openings[i].moves);
+                CHECK(opening.stm == openings[i].stm);
+            }
+        }
+    }
+
+    TEST_CASE("Lazy PGN book keeps games without moves apart") {
+        const std::string file = "tests/data/pgn_book_test.pgn";
+
+        {
+            std::ofstream out(file, std::ios::binary);
+            out << "[Event \"No moves\"]\n"
+                << "[FEN \"8/8/8/8/8/8/8/K6k w - - 0 1\"]\n"
+                << "\n"
+                << "[Event \"Two moves\"]\n"
+                << "\n"
+                << "1. e4 e5 *\n"
+                << "\n"
+                << "[Event \"No moves, no empty line\"]\n"
+                << "[FEN \"8/8/8/8/8/8/8/k6K b - - 0 1\"]\n"
+                << "[Event \"One move\"]\n"
+                << "\n"
+                << "1. d4 *\n";
+        }
+
+        {
+            const auto openings = PgnReader(file).getOpenings();
+            const PgnBook book(file);
+
+            REQUIRE(book.size() == 4);
+            REQUIRE(openings.size() == 4);
+
+            CHECK(book[0].fen == "8/8/8/8/8/8/8/K6k w - - 0 1");
+            CHECK(book[0].moves.empty());
+            CHECK(book[1].moves.size() == 2);
+            CHECK(book[2].fen == "8/8/8/8/8/8/8/k6K b - - 0 1");
+            CHECK(book[2].moves.empty());
+            CHECK(book[3].moves.size() == 1);
+
+            for (std::size_t i = 0; i < book.size(); i++) {
+                CHECK(book[i].fen == openings[i].fen);
+                CHECK(book[i].moves == openings[i].moves);
+            }
+        }
+
+        std::remove(file.c_str());
+    }
+
+    TEST_CASE("Pack openings into the binary format") {
+        const std::vector<std::string> fens = {
+            "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1",
+            "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+            "r3k2r/8/8/8/8/8/8/R3K2R w Kq - 12 40",
+            "1r2k1r1/8/8/8/8/8/8/1R2K1R1 w GBgb - 0 1",
+            "bqnb1rkr/pppppppp/8/8/8/8/PPPPPPPP/BQNB1RKR w HFhf - 0 1",
+            "8/8/8/8/8/8/8/K6k w - - 0 1"};
+
+        std::string packed;
+
+        for (const auto& fen : fens) {
+            packed.clear();
+            BinBook::encode({fen, {}}, packed);
+
+            Opening opening;
+            BinBook::decode(packed, opening);
+
+            CHECK(opening.fen == fen);
+            CHECK(opening.moves.empty());
+            CHECK(opening.stm == chess::Board(fen).sideToMove());
+        }
+
+        // occupancy, two pieces per byte, the flags and the move counters
+        packed.clear();
+        BinBook::encode({"r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1", {}}, packed);
+
+        CHECK(packed.size() == 8 + 3 + 4);
+
+        // piece codes 14 and 15 are not used
+        packed[8] = static_cast<char>(0xff);
+
+        Opening opening;
+        CHECK_THROWS(BinBook::decode(packed, opening));
+
+        // shorter than the occupancy or than the pieces it announces
+        CHECK_THROWS(BinBook::decode(std::string_view(packed.data(), 7), opening));
+        CHECK_THROWS(BinBook::decode(std::string_view(packed.data(), 8 + 3 + 3), opening));
+    }
+
+    TEST_CASE("Convert books to the binary format") {
+        const std::string file = "tests/data/bin_book_test.bin";
+
+        {
+            REQUIRE(BinBook::convert("tests/data/openings.epd", FormatType::EPD, file) == 100);
+
+            const BinBook book(file);
+            const EpdBook epd("tests/data/openings.epd");
+
+            REQUIRE(book.size() == epd.size());
+
+            Opening opening;
+            for (std::size_t i = 0; i < book.size(); i++) {
+                book.get(i, opening);
+
+                CHECK(opening.fen == epd[i]);
+                CHECK(opening.moves.empty());
+            }
+        }
+
+        {
+            const auto openings = PgnReader("tests/data/openings.pgn").getOpenings();
+
+            REQUIRE(BinBook::convert("tests/data/openings.pgn", FormatType::PGN, file) ==
+                    openings.size());
+
+            const BinBook book(file);
+
+            Opening opening;
+            for (std::size_t i = 0; i < openings.size(); i++) {
+                book.get(i, opening);
+
+                const auto& expected = openings[i];
+
+                CHECK(opening.fen == chess::Board(expected.fen).getFen());
+                CHECK(opening.moves == expected.moves);
+                CHECK(opening.stm == expected.stm);
+            }
+        }
+
+        {
+            // let the second entry end past the table
+            std::fstream stream(file, std::ios::in | std::ios::out | std::ios::binary);
+
+            char header[24];
+            stream.read(header, sizeof(header));
+
+            const auto table = binary_io::readLe<uint64_t>(header + 16);
+            const auto size  = binary_io::readLe<uint16_t>(header + 6);
+
+            stream.seekp(std::streamoff(table + 2 * size));
+            stream.write("\xff\xff\xff\xff", 4);
+        }
+
+        {
+            const BinBook book(file);
+
+            Opening opening;
+            CHECK_NOTHROW(book.get(0, opening));
+            CHECK_THROWS(book.get(1, opening));
+        }
+
+        std::remove(file.c_str());
+    }
+
+    TEST_CASE("Random order visits every opening once") {
+        options::Opening config;
+        config.file   = "tests/data/openings.epd";
+        config.format = FormatType::EPD;
+        config.order  = OrderType::RANDOM;
+
+        const EpdBook epd(config.file);
+
+        OpeningBook first(config, 7);
+        OpeningBook second(config, 7);
+
+        std::set<std::string> fens;
+        std::vector<std::string> order;
+
+        for (std::size_t i = 0; i < epd.size(); i++) {
+            order.push_back(first.fetch().fen);
+            fens.insert(order.back());
+        }
+
+        CHECK(fens.size() == epd.size());
+
+        // every book counts its own fetches, the same seed gives the same order
+        CHECK(first.fetch().fen == order[0]);
+
+        for (std::size_t i = 0; i < epd.size(); i++) CHECK(second.fetch().fen == order[i]);
+    }
+
+    TEST_CASE("Fetched openings are prepared once") {
+        options::Opening config;
+        config.file   = "tests/data/openings.pgn";
+        config.format = FormatType::PGN;
+
+        OpeningBook book(config);
+
+        for (int i = 0; i < 20; i++) {
+            const auto opening = book.fetch();
+
+            REQUIRE(opening.prepared);
+
+            const auto& prepared = *opening.prepared;
+
+            chess::Board board(opening.fen);
+            for (std::size_t j = 0; j < opening.moves.size(); j++) {
+                CHECK(prepared.moves[j] == chess::uci::moveToUci(opening.moves[j]));
+                board.makeMove(opening.moves[j]);
+            }
+
+            CHECK(prepared.moves.size() == opening.moves.size());
+            CHECK(prepared.start == "startpos");
+            CHECK(prepared.board.getFen() == board.getFen());
+            CHECK(prepared.board.sideToMove() == opening.stm);
+        }
+
+        // positions without moves are set up by the games themselves
+        config.file   = "tests/data/openings.epd";
+        config.format = FormatType::EPD;
+
+        CHECK(!OpeningBook(config).fetch().prepared);
+    }
+}
+}  // namespace fast_chess
@@ -104,4 +104,144 @@ TEST_SUITE("Option Parsing Tests") {
         CHECK(gameOptions.opening.order == OrderType::RANDOM);
         CHECK(gameOptions.opening.plies == 16);
     }
-}
\ No newline at end of file
+
+    TEST_CASE("Load a config file written by an older version") {
+        // tests/data/config.json lacks every key which has been added since
+        const char *argv[] = {"fast-chess.exe", "-config", "file=tests/data/config.json"};
+
+        cli::OptionsParser options = cli::OptionsParser(3, argv);
+        const auto game_options    = options.getGameOptions();
+
+        CHECK(game_options.event_name == "Baseline");
+        CHECK(game_options.rounds == 40);
+        CHECK(game_options.pgn.file == "baseline.pgn");
+        CHECK(game_options.pgn.track_nodes);
+        CHECK(game_options.resign.score == 600);
+
+        // missing keys keep their defaults
+        const options::Tournament defaults;
+        CHECK(game_options.pgn.flush_games == defaults.pgn.flush_games);
+        CHECK(game_options.type == defaults.type);
+        CHECK(game_options.weight == defaults.weight);
+        CHECK(game_options.verify_pv == defaults.verify_pv);
+        CHECK(game_options.ping == defaults.ping);
+        CHECK(game_options.datagen.file.empty());
+        CHECK(game_options.archive.empty());
+
+        REQUIRE(options.getEngineConfigs().size() == 2);
+        CHECK(options.getEngineConfigs()[1].name == "engine2");
+
+        const auto stats = options.getResults().at("engine1").at("engine2");
+        CHECK(stats.wins == 3);
+        CHECK(stats.draws == 5);
+        CHECK(stats.penta_DD == 2);
+    }
+
+    TEST_CASE("Load an sprt object written by an older version") {
+        const auto sprt = nlohmann::ordered_json::parse(
+                              R"({"alpha": 0.05, "beta": 0.1, "elo0": 0.0, "elo1": 5.0})")
+                              .get<options::Sprt>();
+
+        CHECK(sprt.alpha == 0.05);
+        CHECK(sprt.beta == 0.1);
+        CHECK(sprt.elo0 == 0.0);
+        CHECK(sprt.elo1 == 5.0);
+        CHECK(sprt.model == SprtModel::TRINOMIAL);
+        CHECK(sprt.elo_type == EloType::LOGISTIC);
+
+        // the same object inside tests/data/config.json
+        const char *argv[] = {"fast-chess.exe", "-config", "file=tests/data/config.json"};
+
+        const auto game_options = cli::OptionsParser(3, argv).getGameOptions();
+
+        CHECK(game_options.sprt.elo1 == 5.0);
+        CHECK(game_options.sprt.model == SprtModel::TRINOMIAL);
+        CHECK(game_options.sprt.elo_type == EloType::LOGISTIC);
+    }
+
+    TEST_CASE("Split the arguments of several tests") {
+        const char* argv[] = {"fast-chess.exe",
+                              "-concurrency",
+                              "4",
+                              "-each",
+                              "tc=10+0.1",
+                              "-rounds",
+                              "50",
+                              "-test",
+                              "weight=3",
+                              "-engine",
+                              "name=a",
+                              "cmd=tests/mock/engine/dummy_engine",
+                              "-engine",
+                              "name=b",
+                              "cmd=tests/mock/engine/dummy_engine",
+                              "tc=20+0.2",
+                              "-rounds",
+                              "10",
+                              "-test",
+                              "-engine",
+                              "name=c",
+                              "cmd=tests/mock/engine/dummy_engine",
+                              "-engine",
+                              "name=d",
+                              "cmd=tests/mock/engine/dummy_engine"};
+
+        const auto tests = cli::OptionsParser::splitTests(25, argv);
+
+        REQUIRE(tests.size() == 2);
+        CHECK(tests[0].size() == 1 + 6 + 11);
+        CHECK(tests[1].size() == 1 + 6 + 7);
+
+        // the shared options come first
+        CHECK(std::string_view(tests[1][1]) == "-concurrency");
+        CHECK(std::string_view(tests[1][7]) == "-test");
+
+        auto args               = tests[0];
+        const auto options      = cli::OptionsParser(int(args.size()), args.data());
+        const auto game_options = options.getGameOptions();
+        const auto configs      = options.getEngineConfigs();
+
+        CHECK(game_options.weight == 3);
+        CHECK(game_options.concurrency == 4);
+        REQUIRE(configs.size() == 2);
+        CHECK(configs[0].name == "a");
+        CHECK(configs[0].limit.tc.time == 10000);
+        CHECK(configs[1].name == "b");
+
+        // the options of a test override the shared ones
+        CHECK(game_options.rounds == 10);
+        CHECK(configs[1].limit.tc.time == 20000);
+
+        args                   = tests[1];
+        const auto second_test = cli::OptionsParser(int(args.size()), args.data());
+
+        CHECK(second_test.getGameOptions().rounds == 50);
+        CHECK(second_test.getEngineConfigs()[1].limit.tc.time == 10000);
+
+        CHECK(cli::OptionsParser::splitTests(7, argv).empty());
+    }
+
+    TEST_CASE("Options of several tests which are not shared") {
+        const char* argv[] = {"fast-chess.exe",
+                              "-recover",
+                              "-test",
+                              "-engine",
+                              "name=a",
+                              "cmd=tests/mock/engine/dummy_engine",
+                              "-engine",
+                              "name=b",
+                              "cmd=tests/mock/engine/dummy_engine"};
+
+        // each test recovers its own engines
+        auto args = cli::OptionsParser::splitTests(9, argv).front();
+        CHECK(cli::OptionsParser(int(args.size()), args.data()).getGameOptions().recover);
+
+        // but there is only one config.json
+        const char* config[] = {"fast-chess.exe", "-config", "file=tests/data/config.json",
+                                "-test"};
+
+        CHECK_THROWS_AS(static_cast<void>(cli::OptionsParser::splitTests(4, config)),
+                        std::runtime_error);
+        CHECK(cli::OptionsParser::splitTests(3, config).empty());
+    }
+}
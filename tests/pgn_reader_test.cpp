@@ -1,5 +1,8 @@
 #include <pgn/pgn_reader.hpp>
 
+#include <fstream>
+#include <sstream>
+
 #include <chess.hpp>
 #include "doctest/doctest.hpp"
 
@@ -114,5 +117,30 @@ TEST_SUITE("PGN Reader") {
             }
         }
     }
+
+    TEST_CASE("Parsing in chunks keeps the order of the games") {
+        std::ifstream file("tests/data/test.pgn");
+        std::stringstream ss;
+        ss << file.rdbuf();
+
+        // every game occurs 50 times, so that the chunks fall into all parts of a game
+        std::string pgn;
+        for (int i = 0; i < 50; i++) pgn += ss.str() + "\n";
+
+        const auto expected = PgnReader::parseGames(pgn, 1);
+
+        REQUIRE(expected.size() == 300);
+
+        for (std::size_t chunks : {2, 3, 7, 64, 1000}) {
+            const auto games = PgnReader::parseGames(pgn, chunks);
+
+            REQUIRE(games.size() == expected.size());
+
+            for (std::size_t i = 0; i < games.size(); i++) {
+                CHECK(games[i].fen == expected[i].fen);
+                CHECK(games[i].moves == expected[i].moves);
+            }
+        }
+    }
 }
 }  // namespace fast_chess
@@ -1,3 +1,5 @@
+#include <matchmaking/match/position_buffer.hpp>
+#include <matchmaking/match/pv_verifier.hpp>
 #include <matchmaking/player.hpp>
 
 #include "doctest/doctest.hpp"
@@ -21,5 +23,47 @@ TEST_SUITE("Player Test") {
               "position fen rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1 moves e2e4 "
               "e7e5");
     }
+
+    TEST_CASE("Test PositionBuffer") {
+        const auto fen =
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - "
+            "0 1";
+
+        PositionBuffer position;
+
+        position.reset("startpos");
+        CHECK(position.get() == Player::buildPositionInput({}, "startpos"));
+
+        position.push("e2e4");
+        position.push("e7e5");
+        CHECK(position.get() == Player::buildPositionInput({"e2e4", "e7e5"}, "startpos"));
+
+        position.reset(fen);
+        CHECK(position.get() == Player::buildPositionInput({}, fen));
+
+        position.push("e2e4");
+        CHECK(position.get() == Player::buildPositionInput({"e2e4"}, fen));
+        CHECK(position.line() == Player::buildPositionInput({"e2e4"}, fen) + "\n");
+    }
+
+    TEST_CASE("Test PvVerifier") {
+        chess::Board board;
+        board.makeMove(chess::uci::uciToMove(board, "e2e4"));
+
+        const auto fen = board.getFen();
+
+        PvVerifier verifier;
+
+        CHECK(verifier.verify(board, "e7e5 g1f3 b8c6 f1b5") == "");
+        CHECK(verifier.verify(board, "e7e5  g1f3 e8e7 e1e2") == "");
+        CHECK(verifier.verify(board, "e7e5 e1e2 e8e7 e4e5") == "e4e5");
+        CHECK(verifier.verify(board, "g1f3") == "g1f3");
+        CHECK(verifier.verify(board, "") == "");
+
+        // the board is unchanged, including its history
+        CHECK(board.getFen() == fen);
+        board.unmakeMove(chess::uci::uciToMove(chess::Board(), "e2e4"));
+        CHECK(board.getFen() == chess::Board().getFen());
+    }
 }
 }  // namespace fast_chess
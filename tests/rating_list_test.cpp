@@ -0,0 +1,87 @@
+#include <matchmaking/elo/rating_list.hpp>
+
+#include <cmath>
+
+#include "doctest/doctest.hpp"
+
+using namespace fast_chess;
+
+TEST_SUITE("Rating List Tests") {
+    TEST_CASE("Two engines match the head to head elo") {
+        RatingList list({"a", "b"});
+        list.add(0, 1, Stats(64, 36, 0));
+        list.update();
+
+        const auto ratings = list.get();
+
+        REQUIRE(ratings.size() == 2);
+        CHECK(ratings[0].name == "a");
+        CHECK(ratings[0].games == 100);
+        CHECK(ratings[0].score == doctest::Approx(0.64));
+
+        // 65 of 102 points including the prior draws
+        const double p = 65.0 / 102.0;
+        CHECK(ratings[0].elo - ratings[1].elo ==
+              doctest::Approx(400.0 * std::log10(p / (1 - p))).epsilon(0.001));
+        CHECK(ratings[0].error == doctest::Approx(ratings[1].error));
+    }
+
+    TEST_CASE("Ratings of engines which never met are linked by common opponents") {
+        RatingList list({"a", "b", "c"});
+        list.add(0, 1, Stats(300, 200, 500));
+        list.add(1, 2, Stats(300, 200, 500));
+        list.update();
+
+        const auto ratings = list.get();
+
+        CHECK(ratings[0].name == "a");
+        CHECK(ratings[1].name == "b");
+        CHECK(ratings[2].name == "c");
+        CHECK(ratings[1].elo == doctest::Approx(0.0).epsilon(0.01));
+        CHECK(ratings[0].elo == doctest::Approx(-ratings[2].elo));
+
+        // a and c are only compared through b
+        CHECK(ratings[0].error > ratings[1].error);
+        CHECK(std::isfinite(ratings[0].error));
+    }
+
+    TEST_CASE("Incremental updates reach the same fit") {
+        RatingList incremental({"a", "b", "c", "d"});
+        RatingList batch({"a", "b", "c", "d"});
+
+        for (int i = 0; i < 200; i++) {
+            const std::size_t first  = i % 4;
+            const std::size_t second = (i / 4 + i + 1) % 4;
+
+            if (first == second) continue;
+
+            const auto stats = i % 3 == 0   ? Stats(1, 0, 0)
+                               : i % 3 == 1 ? Stats(0, 0, 1)
+                                            : Stats(0, 1, 0);
+
+            incremental.add(first, second, stats);
+            incremental.update();
+
+            batch.add(first, second, stats);
+        }
+
+        batch.update();
+
+        const auto a = incremental.get();
+        const auto b = batch.get();
+
+        for (std::size_t i = 0; i < a.size(); i++) {
+            CHECK(a[i].name == b[i].name);
+            CHECK(a[i].elo == doctest::Approx(b[i].elo).epsilon(0.001));
+        }
+    }
+
+    TEST_CASE("Engines without a common opponent have no error") {
+        RatingList list({"a", "b", "c", "d"});
+        list.add(0, 1, Stats(10, 5, 5));
+        list.add(2, 3, Stats(10, 5, 5));
+        list.update();
+
+        for (const auto &rating : list.get()) CHECK(std::isinf(rating.error));
+    }
+}
@@ -14,7 +14,7 @@ TEST_SUITE("Result Tests") {
 
         const auto stats = Stats(1, 2, 3);
 
-        Result result;
+        Result result({engine1.name, engine2.name});
         result.updateStats({engine1, engine2}, stats);
 
         CHECK(result.getStats(engine1.name, engine2.name) == stats);
@@ -29,7 +29,7 @@ TEST_SUITE("Result Tests") {
 
         auto stats = Stats(1, 2, 3);
 
-        Result result;
+        Result result({engine1.name, engine2.name});
         result.updateStats({engine1, engine2}, stats);
         result.updateStats({engine1, engine2}, stats);
 
@@ -43,7 +43,7 @@ TEST_SUITE("Result Tests") {
         engine1.name = "engine1";
         engine2.name = "engine2";
 
-        Result result;
+        Result result({engine1.name, engine2.name});
 
         const auto stats = Stats{1, 2, 3};
 
@@ -64,11 +64,43 @@ TEST_SUITE("Result Tests") {
         stats_map results = {{engine1.name, {{engine2.name, Stats(1, 2, 3)}}},
                              {engine2.name, {{engine1.name, Stats(0, 0, 0)}}}};
 
-        Result result;
+        Result result({engine1.name, engine2.name});
         result.setResults(results);
 
         CHECK(result.getStats(engine1.name, engine2.name) == Stats(1, 2, 3));
         CHECK(result.getResults() == results);
     }
+
+    TEST_CASE("Engines are numbered in registration order") {
+        Result result({"engine1", "engine2", "engine3"});
+
+        CHECK(result.size() == 3);
+        CHECK(result.id("engine2") == 1);
+
+        // the engines are fixed once the results are created
+        CHECK_THROWS_AS(static_cast<void>(result.id("engine4")), std::out_of_range);
+        CHECK(result.size() == 3);
+
+        result.updateStats(2, 0, Stats(4, 1, 2));
+
+        CHECK(result.getStats(0, 2) == Stats(1, 4, 2));
+        CHECK(result.getStats("engine3", "engine1") == Stats(4, 1, 2));
+        CHECK(result.getResults() == stats_map{{"engine3", {{"engine1", Stats(4, 1, 2)}}}});
+    }
+
+    TEST_CASE("Both games of a round are paired up") {
+        RoundResult round;
+
+        CHECK_FALSE(round.add(Stats(1, 0, 0)).has_value());
+
+        const auto pair = round.add(Stats(0, 0, 1));
+
+        REQUIRE(pair.has_value());
+
+        auto expected     = Stats(1, 0, 1);
+        expected.penta_WD = 1;
+
+        CHECK(pair.value() == expected);
+    }
 }
 }  // namespace fast_chess
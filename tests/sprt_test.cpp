@@ -0,0 +1,49 @@
+#include <matchmaking/sprt/sprt.hpp>
+
+#include "doctest/doctest.hpp"
+
+using namespace fast_chess;
+
+TEST_SUITE("SPRT Tests") {
+    TEST_CASE("Pentanomial LLR") {
+        SPRT sprt(0.05, 0.05, 0.0, 5.0, SprtModel::PENTANOMIAL);
+
+        CHECK(sprt.getLLR(10, 40, 100, 50, 12) == doctest::Approx(0.377).epsilon(0.01));
+
+        // a single kind of outcome
+        CHECK(sprt.getLLR(0, 0, 20, 0, 0) == 0.0);
+    }
+
+    TEST_CASE("Pentanomial model uses the pair counters") {
+        Stats stats(135, 110, 175);
+        stats.penta_LL = 5;
+        stats.penta_LD = 30;
+        stats.penta_WL = 70;
+        stats.penta_DD = 50;
+        stats.penta_WD = 45;
+        stats.penta_WW = 10;
+
+        const SPRT trinomial(0.05, 0.05, 0.0, 5.0);
+        const SPRT pentanomial(0.05, 0.05, 0.0, 5.0, SprtModel::PENTANOMIAL);
+
+        CHECK(trinomial.getLLR(stats) == doctest::Approx(0.545).epsilon(0.01));
+        CHECK(pentanomial.getLLR(stats) == doctest::Approx(1.006).epsilon(0.01));
+    }
+
+    TEST_CASE("Normalized elo bounds") {
+        Stats stats(135, 110, 175);
+        stats.penta_LL = 5;
+        stats.penta_LD = 30;
+        stats.penta_WL = 70;
+        stats.penta_DD = 50;
+        stats.penta_WD = 45;
+        stats.penta_WW = 10;
+
+        const SPRT trinomial(0.05, 0.05, 0.0, 5.0, SprtModel::TRINOMIAL, EloType::NORMALIZED);
+        const SPRT pentanomial(0.05, 0.05, 0.0, 5.0, SprtModel::PENTANOMIAL,
+                               EloType::NORMALIZED);
+
+        CHECK(trinomial.getLLR(stats) == doctest::Approx(0.429).epsilon(0.01));
+        CHECK(pentanomial.getLLR(stats) == doctest::Approx(0.598).epsilon(0.01));
+    }
+}
@@ -0,0 +1,113 @@
+#include <matchmaking/tournament/swiss/swiss_pairing.hpp>
+
+#include <deque>
+#include <set>
+#include <utility>
+
+#include "doctest/doctest.hpp"
+
+namespace fast_chess {
+TEST_SUITE("Swiss Pairing") {
+    TEST_CASE("Every engine plays all of its rounds without rematches") {
+        constexpr std::size_t engines = 16;
+        constexpr int rounds          = 4;
+
+        SwissPairing pairing(engines, rounds);
+
+        std::deque<std::pair<std::size_t, std::size_t>> playing;
+        std::set<std::pair<std::size_t, std::size_t>> played;
+
+        std::size_t pairings = 0;
+
+        while (!pairing.done()) {
+            // pair as many engines as possible, then finish the oldest pairing
+            while (const auto engines = pairing.next()) {
+                const auto [first, second] = engines.value();
+
+                CHECK(played.insert(std::minmax(first, second)).second);
+
+                playing.push_back(engines.value());
+                pairings++;
+            }
+
+            REQUIRE(!playing.empty());
+
+            const auto [first, second] = playing.front();
+            playing.pop_front();
+
+            // the lower id always wins
+            pairing.finish(first, second, first < second ? Stats(2, 0, 0) : Stats(0, 2, 0));
+        }
+
+        CHECK(pairings == pairing.maxPairings());
+        CHECK(pairings == engines * rounds / 2);
+
+        for (std::size_t i = 0; i < engines; i++) CHECK(pairing.rounds(i) == rounds);
+
+        // the strongest engines meet each other, so only the first one wins all pairings
+        CHECK(pairing.score(0) == 4 * rounds);
+        CHECK(pairing.score(1) < 4 * rounds);
+        CHECK(pairing.score(engines - 1) == 0);
+    }
+
+    TEST_CASE("Engines are paired while others are still playing") {
+        SwissPairing pairing(4, 2);
+
+        const auto first  = pairing.next();
+        const auto second = pairing.next();
+
+        REQUIRE(first.has_value());
+        REQUIRE(second.has_value());
+        CHECK(!pairing.next().has_value());
+
+        // the engines of the second pairing already played each other, they rather wait for the
+        // opponents they have not played yet
+        pairing.finish(second->first, second->second, Stats(1, 0, 1));
+        CHECK(!pairing.next().has_value());
+
+        pairing.finish(first->first, first->second, Stats(0, 0, 2));
+
+        const auto third = pairing.next();
+        REQUIRE(third.has_value());
+        CHECK(third->first != third->second);
+
+        const auto fourth = pairing.next();
+        REQUIRE(fourth.has_value());
+        CHECK(!pairing.next().has_value());
+        CHECK(!pairing.done());
+    }
+
+    TEST_CASE("The first move alternates") {
+        SwissPairing pairing(2, 3);
+
+        std::size_t previous = 2;
+
+        for (int i = 0; i < 3; i++) {
+            const auto engines = pairing.next();
+            REQUIRE(engines.has_value());
+
+            CHECK(engines->first != previous);
+            previous = engines->first;
+
+            pairing.finish(engines->first, engines->second, Stats(0, 0, 1));
+        }
+
+        CHECK(pairing.done());
+        CHECK(pairing.score(0) == 3);
+        CHECK(pairing.score(1) == 3);
+    }
+
+    TEST_CASE("An odd engine is left without an opponent") {
+        SwissPairing pairing(3, 1);
+
+        const auto engines = pairing.next();
+        REQUIRE(engines.has_value());
+        CHECK(!pairing.next().has_value());
+
+        pairing.finish(engines->first, engines->second, Stats(1, 0, 0));
+
+        CHECK(pairing.done());
+        CHECK(pairing.maxPairings() == 1);
+    }
+}
+}  // namespace fast_chess
@@ -0,0 +1,53 @@
+#include <matchmaking/tournament/scheduler/test_scheduler.hpp>
+
+#include <vector>
+
+#include "doctest/doctest.hpp"
+
+namespace fast_chess {
+TEST_SUITE("Test Scheduler") {
+    TEST_CASE("Workers are shared by weight") {
+        std::vector<TestScheduler::Share> shares(3);
+        shares[0].weight = 2;
+        shares[1].weight = 1;
+        shares[2].weight = 1;
+
+        std::vector<int> picks;
+
+        for (int i = 0; i < 8; i++) {
+            const auto test = TestScheduler::pick(shares);
+            REQUIRE(test.has_value());
+
+            shares[test.value()].games++;
+            picks.push_back(int(test.value()));
+        }
+
+        CHECK(picks == std::vector<int>{0, 1, 2, 0, 0, 1, 2, 0});
+    }
+
+    TEST_CASE("A decided test gives its workers to the others") {
+        std::vector<TestScheduler::Share> shares(2);
+        shares[0].games = 30;
+        shares[1].games = 10;
+
+        CHECK(TestScheduler::pick(shares) == 1);
+
+        shares[1].playing = false;
+        CHECK(TestScheduler::pick(shares) == 0);
+
+        shares[0].playing = false;
+        CHECK(!TestScheduler::pick(shares).has_value());
+    }
+
+    TEST_CASE("A test waiting for its running games is skipped") {
+        std::vector<TestScheduler::Share> shares(2);
+        shares[1].games = 10;
+
+        shares[0].waiting = true;
+        CHECK(TestScheduler::pick(shares) == 1);
+
+        shares[1].waiting = true;
+        CHECK(!TestScheduler::pick(shares).has_value());
+    }
+}
+}  // namespace fast_chess
@@ -0,0 +1,104 @@
+#include <datagen/training_data.hpp>
+
+#include <matchmaking/book/bin_book.hpp>
+
+#include "doctest/doctest.hpp"
+
+namespace fast_chess {
+TEST_SUITE("Training Data Tests") {
+    MatchData blackWins() {
+        MatchData match;
+        match.players.first.color   = chess::Color::WHITE;
+        match.players.first.result  = chess::GameResult::LOSE;
+        match.players.second.color  = chess::Color::BLACK;
+        match.players.second.result = chess::GameResult::WIN;
+        return match;
+    }
+
+    UciInfo score(ScoreType type, int value) {
+        UciInfo info;
+        info.score_type = type;
+        info.score      = value;
+        return info;
+    }
+
+    TEST_CASE("Scores are written from white's point of view") {
+        options::Datagen options;
+        options.file = "unused";
+
+        TrainingData data(options);
+
+        chess::Board board;
+        data.add(board, chess::uci::uciToMove(board, "e2e4"), score(ScoreType::CP, 37), 0);
+
+        board.makeMove(chess::uci::uciToMove(board, "e2e4"));
+        data.add(board, chess::uci::uciToMove(board, "e7e5"), score(ScoreType::CP, 12), 1);
+
+        board.makeMove(chess::uci::uciToMove(board, "e7e5"));
+        data.add(board, chess::uci::uciToMove(board, "g1f3"), score(ScoreType::MATE, -3), 2);
+
+        // no score at all
+        data.add(board, chess::uci::uciToMove(board, "g1f3"), UciInfo(), 2);
+
+        CHECK(data.get(blackWins()) ==
+              "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1 | 37 | 0.0\n"
+              "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1 | -12 | 0.0\n"
+              "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2 | -31997 | 0.0\n");
+    }
+
+    TEST_CASE("Filtered positions are skipped") {
+        options::Datagen options;
+        options.file          = "unused";
+        options.min_ply       = 1;
+        options.skip_checks   = true;
+        options.skip_captures = true;
+        options.skip_mates    = true;
+
+        TrainingData data(options);
+
+        chess::Board board;
+        data.add(board, chess::uci::uciToMove(board, "e2e4"), score(ScoreType::CP, 20), 0);
+
+        board.setFen("rnbqkbnr/ppp2ppp/8/3pp3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 0 3");
+        data.add(board, chess::uci::uciToMove(board, "e4d5"), score(ScoreType::CP, 20), 4);
+        data.add(board, chess::uci::uciToMove(board, "f1b5"), score(ScoreType::MATE, 8), 4);
+        data.add(board, chess::uci::uciToMove(board, "f1b5"), score(ScoreType::CP, 20), 4);
+
+        board.setFen("rnbqk1nr/pppp1ppp/8/4p3/1b2P3/3P4/PPP2PPP/RNBQKBNR w KQkq - 1 3");
+        data.add(board, chess::uci::uciToMove(board, "c2c3"), score(ScoreType::CP, -20), 4);
+
+        CHECK(data.size() == 1);
+
+        data.clear();
+        CHECK(data.size() == 0);
+    }
+
+    TEST_CASE("Binary records hold the packed position") {
+        options::Datagen options;
+        options.file   = "unused";
+        options.format = DatagenFormat::BIN;
+
+        TrainingData data(options);
+
+        chess::Board board;
+        data.add(board, chess::uci::uciToMove(board, "d2d4"), score(ScoreType::CP, -150), 7);
+
+        auto match                  = blackWins();
+        match.players.first.result  = chess::GameResult::DRAW;
+        match.players.second.result = chess::GameResult::DRAW;
+
+        const auto record = data.get(match);
+        const auto size   = BinBook::positionSize(record);
+
+        REQUIRE(record.size() == size + 5);
+
+        Opening opening;
+        BinBook::decode(std::string_view(record.data(), size), opening);
+
+        CHECK(opening.fen == board.getFen());
+        CHECK(int16_t(uint8_t(record[size]) | uint8_t(record[size + 1]) << 8) == -150);
+        CHECK(record[size + 2] == 1);
+        CHECK(uint8_t(record[size + 3]) == 7);
+    }
+}
+}  // namespace fast_chess
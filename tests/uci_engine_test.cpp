@@ -2,8 +2,11 @@
 #include <types/engine_config.hpp>
 
 #include <chrono>
+#include <memory>
+#include <string>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 #include "doctest/doctest.hpp"
 
@@ -136,4 +139,175 @@ TEST_SUITE("Uci Engine Communication Tests") {
         CHECK(uci_engine.output().size() == 1);
         CHECK(uci_engine.output()[0] == "done");
     }
+
+    TEST_CASE("Testing engine hangup detection") {
+        EngineConfiguration config;
+#ifdef _WIN64
+        config.cmd = path + "dummy_engine.exe";
+#else
+        config.cmd = path + "dummy_engine";
+#endif
+        UciEngine uci_engine = UciEngine(config);
+
+        CHECK(uci_engine.isAlive());
+
+        // the engine exits, waiting for a bestmove must not run into the timeout
+        uci_engine.writeEngine("quit");
+        const auto res = uci_engine.readEngine("bestmove", std::chrono::milliseconds(5000));
+        CHECK(res == Process::Status::ERR);
+
+        bool alive = true;
+        for (int i = 0; i < 100 && alive; i++) {
+            alive = uci_engine.isAlive();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        CHECK(!alive);
+        CHECK(UciEngine::skippedPings() > 0);
+    }
+
+    TEST_CASE("Parsing uci info lines") {
+        UciInfo info;
+
+        CHECK(parseInfo(
+            "info depth 12 seldepth 18 multipv 1 score cp -35 upperbound nodes 123456 nps 987654 "
+            "hashfull 42 tbhits 7 time 125 pv e2e4 e7e5 g1f3 b8c6",
+            info));
+        CHECK(info.depth == 12);
+        CHECK(info.seldepth == 18);
+        CHECK(info.score_type == ScoreType::CP);
+        CHECK(info.score == -35);
+        CHECK(info.upperbound);
+        CHECK(!info.lowerbound);
+        CHECK(info.nodes == 123456);
+        CHECK(info.nps == 987654);
+        CHECK(info.hashfull == 42);
+        CHECK(info.tbhits == 7);
+        CHECK(info.pv == "e2e4 e7e5 g1f3 b8c6");
+
+        CHECK(parseInfo("info depth 30 score mate -3 pv a7a8q b1a1 string not a move", info));
+        CHECK(info.score_type == ScoreType::MATE);
+        CHECK(info.score == -3);
+        CHECK(info.pv == "a7a8q b1a1");
+
+        CHECK(parseInfo("info string score cp 100", info));
+        CHECK(info.score_type == ScoreType::ERR);
+
+        CHECK(!parseInfo("bestmove e2e4 ponder e7e5", info));
+        CHECK(!parseInfo("", info));
+    }
+
+    TEST_CASE("Snapshot of the last info line") {
+        EngineConfiguration config;
+#ifdef _WIN64
+        config.cmd = path + "dummy_engine.exe";
+#else
+        config.cmd = path + "dummy_engine";
+#endif
+
+        UciEngine uci_engine = UciEngine(config);
+
+        uci_engine.writeEngine("info");
+        CHECK(uci_engine.readEngine("info depth 23") == Process::Status::OK);
+
+        const auto& info = uci_engine.lastInfo();
+        CHECK(info.depth == 23);
+        CHECK(info.seldepth == 24);
+        CHECK(info.score_type == ScoreType::CP);
+        CHECK(info.score == 20);
+        CHECK(info.nodes == 11116018);
+        CHECK(info.pv.substr(0, 9) == "d2d4 g8f6");
+
+        CHECK(uci_engine.isResponsive());
+        CHECK(uci_engine.lastScoreType() == ScoreType::ERR);
+    }
+
+    TEST_CASE("Capture policy of the engine output") {
+        EngineConfiguration config;
+#ifdef _WIN64
+        config.cmd = path + "dummy_engine.exe";
+#else
+        config.cmd = path + "dummy_engine";
+#endif
+
+        const auto readInfo = [&config](CapturePolicy::Mode mode, std::size_t lines) {
+            config.capture = {mode, lines};
+
+            auto uci_engine = std::make_unique<UciEngine>(config);
+
+            uci_engine->writeEngine("info");
+            CHECK(uci_engine->readEngine("info depth 23") == Process::Status::OK);
+            CHECK(uci_engine->output().back().rfind("info depth 23", 0) == 0);
+            CHECK(uci_engine->peakOutputBytes() > 0);
+
+            return uci_engine;
+        };
+
+        CHECK(readInfo(CapturePolicy::Mode::ALL, 0)->output().size() == 23);
+        CHECK(readInfo(CapturePolicy::Mode::SCORED, 0)->output().size() == 23);
+        CHECK(readInfo(CapturePolicy::Mode::LAST, 0)->output().size() == 1);
+
+        // dropped lines are still parsed
+        const auto dropped = readInfo(CapturePolicy::Mode::LAST, 0);
+        CHECK(dropped->infoLines() == 23);
+        CHECK(dropped->lastInfo().score_type == ScoreType::CP);
+
+        dropped->collectPvs(true);
+        dropped->writeEngine("info");
+        CHECK(dropped->readEngine("info depth 23") == Process::Status::OK);
+        CHECK(dropped->output().size() == 1);
+        CHECK(dropped->pvs().size() == 23);
+        CHECK(dropped->pvs().front() == "c2c4");
+
+        // the awaited line is kept in addition to the last 5 info lines
+        const auto engine = readInfo(CapturePolicy::Mode::LAST, 5);
+        CHECK(engine->output().size() == 6);
+        CHECK(engine->output().front().rfind("info depth 18", 0) == 0);
+        CHECK(engine->lastInfo().depth == 23);
+
+        // the peak is bounded by the kept lines
+        CHECK(engine->peakOutputBytes() < readInfo(CapturePolicy::Mode::ALL, 0)->peakOutputBytes());
+    }
+
+#ifdef __linux__
+    TEST_CASE("Engines of several fibers share the thread of the epoll reactor") {
+        EngineConfiguration config;
+        config.cmd = path + "dummy_engine";
+
+        std::vector<std::string> events;
+
+        const auto game = [&config, &events](const std::string& name) {
+            UciEngine uci_engine = UciEngine(config);
+
+            uci_engine.writeEngine("sleep");
+            CHECK(uci_engine.readEngine("done", std::chrono::milliseconds(100)) ==
+                  Process::Status::TIMEOUT);
+            events.push_back(name + " timeout");
+
+            CHECK(uci_engine.readEngine("done", std::chrono::milliseconds(5000)) ==
+                  Process::Status::OK);
+            events.push_back(name + " done");
+        };
+
+        EpollReactor reactor;
+        reactor.spawn([&game] { game("first"); });
+        reactor.spawn([&game] { game("second"); });
+
+        CHECK(EpollReactor::current() == nullptr);
+
+        const auto start = std::chrono::steady_clock::now();
+        reactor.run();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        // both engines slept at the same time
+        CHECK(elapsed < std::chrono::milliseconds(1800));
+
+        // a fiber which timed out did not hold up the other one
+        REQUIRE(events.size() == 4);
+        CHECK(events[0].find("timeout") != std::string::npos);
+        CHECK(events[1].find("timeout") != std::string::npos);
+        CHECK(events[2].find("done") != std::string::npos);
+        CHECK(events[3].find("done") != std::string::npos);
+    }
+#endif
 }
\ No newline at end of file